@@ -0,0 +1,458 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""Run the estimators on the same replay log and compare them
+
+Usage: python estimator_shootout.py <log.px4log> [-b build dir] [-e name ...]
+                                    [-r reference log] [-s seconds] [-o report]
+
+The log has to contain the ekf2 replay messages (recorded with EKF2_REC_RPL
+set). Every estimator configuration is started in the posix_sitl_replay build
+and fed from the log by ekf2_replay in realtime mode, one configuration after
+the other since they all publish the same topics. For each of them the report
+lists
+
+    - CPU time per imu sample of the estimator tasks, taken from the per
+      thread times in /proc, and the replay latency perf counter
+    - peak resident memory of the process, which differs between the runs
+      only by the estimators started
+    - attitude error against ATT and position error against GPS of the
+      reference log, which is the input log unless given with -r
+
+The replayed logs are kept as <name>.px4log next to the report."""
+
+from __future__ import print_function
+
+import argparse
+import bisect
+import math
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+# estimator configurations, the attitude estimator is listed first
+CONFIGS = [
+    ("ekf2", ["ekf2 start --replay"]),
+    ("ekf_att_pos_estimator", ["ekf_att_pos_estimator start"]),
+    ("q_inav", ["attitude_estimator_q start", "position_estimator_inav start"]),
+    ("q_lpe", ["attitude_estimator_q start", "local_position_estimator start"]),
+    ("ekf_inav", ["attitude_estimator_ekf start", "position_estimator_inav start"]),
+]
+
+# thread names of the estimator tasks, as truncated by the kernel
+TASK_NAMES = {
+    "ekf2": "ekf2",
+    "ekf_att_pos_estimator": "ekf_att_pos_est",
+    "attitude_estimator_q": "attitude_estima",
+    "attitude_estimator_ekf": "attitude_estima",
+    "position_estimator_inav": "position_estima",
+    "local_position_estimator": "lp_estimator",
+}
+
+REPLAY_LOG = "replay.px4log"
+REPLAYED_LOG = "replay_replayed.px4log"
+PERF_DONE = "ekf2_replay_timeout"
+EARTH_RADIUS = 6371000.0
+
+
+class LogReader:
+    """Minimal sdlog2 reader, returns the samples of the requested messages
+    stamped with the last TIME message before them"""
+
+    HEAD = b"\xa3\x95"
+    FORMAT_TYPE = 0x80
+    FORMAT_LEN = 89
+    FORMAT_TO_STRUCT = {
+        "b": ("b", None), "B": ("B", None), "h": ("h", None), "H": ("H", None),
+        "i": ("i", None), "I": ("I", None), "f": ("f", None), "d": ("d", None),
+        "n": ("4s", None), "N": ("16s", None), "Z": ("64s", None),
+        "c": ("h", 0.01), "C": ("H", 0.01), "e": ("i", 0.01), "E": ("I", 0.01),
+        "L": ("i", 0.0000001), "M": ("b", None), "q": ("q", None), "Q": ("Q", None),
+    }
+
+    def __init__(self, file_name):
+        with open(file_name, "rb") as f:
+            self.data = f.read()
+
+    def read(self, names):
+        samples = dict((name, []) for name in names)
+        formats = {}
+        t = None
+        ptr = 0
+
+        while ptr + 3 <= len(self.data):
+            if self.data[ptr:ptr + 2] != self.HEAD:
+                # the replay log ends where the input log ended
+                break
+
+            msg_type = bytearray(self.data[ptr + 2:ptr + 3])[0]
+
+            if msg_type == self.FORMAT_TYPE:
+                f_type, f_len, f_name, f_format, f_labels = struct.unpack(
+                    "BB4s16s64s", self.data[ptr + 3:ptr + self.FORMAT_LEN])
+                fmt = "<"
+                mults = []
+
+                for c in f_format.split(b"\0")[0].decode("ascii"):
+                    fmt += self.FORMAT_TO_STRUCT[c][0]
+                    mults.append(self.FORMAT_TO_STRUCT[c][1])
+
+                formats[f_type] = (f_len, f_name.split(b"\0")[0].decode("ascii"), fmt, mults,
+                                   f_labels.split(b"\0")[0].decode("ascii").split(","))
+                ptr += self.FORMAT_LEN
+                continue
+
+            if msg_type not in formats:
+                break
+
+            f_len, f_name, fmt, mults, labels = formats[msg_type]
+
+            if ptr + f_len > len(self.data):
+                break
+
+            if f_name == "TIME" or f_name in samples:
+                values = struct.unpack(fmt, self.data[ptr + 3:ptr + f_len])
+                values = [v * m if m is not None else v for v, m in zip(values, mults)]
+
+                if f_name == "TIME":
+                    t = values[0] * 1e-6
+
+                elif t is not None:
+                    samples[f_name].append((t, dict(zip(labels, values))))
+
+            ptr += f_len
+
+        return samples
+
+
+def thread_times(pid):
+    """CPU seconds per thread name"""
+    ticks = float(os.sysconf("SC_CLK_TCK"))
+    times = {}
+
+    for tid in os.listdir("/proc/%d/task" % pid):
+        try:
+            with open("/proc/%d/task/%s/stat" % (pid, tid)) as f:
+                stat = f.read()
+
+        except IOError:
+            continue
+
+        # the name is in parentheses and may contain spaces
+        name = stat[stat.index("(") + 1:stat.rindex(")")]
+        fields = stat[stat.rindex(")") + 2:].split()
+        times[name] = times.get(name, 0.0) + (int(fields[11]) + int(fields[12])) / ticks
+
+    return times
+
+
+def memory(pid):
+    """Peak and current resident memory in kB"""
+    values = {}
+
+    with open("/proc/%d/status" % pid) as f:
+        for line in f:
+            key, _, value = line.partition(":")
+
+            if key in ("VmHWM", "VmRSS"):
+                values[key] = int(value.split()[0])
+
+    return values.get("VmHWM", 0), values.get("VmRSS", 0)
+
+
+def run_config(posix_dir, log_file, name, commands, timeout):
+    """Replay the log through one estimator configuration"""
+    rootfs = os.path.join(posix_dir, "rootfs")
+    shutil.copy(log_file, os.path.join(rootfs, REPLAY_LOG))
+
+    if os.path.exists(os.path.join(rootfs, REPLAYED_LOG)):
+        os.remove(os.path.join(rootfs, REPLAYED_LOG))
+
+    # the replay module fills this with the EKF2 parameters of the log if it is empty
+    open(os.path.join(rootfs, "replay_params.txt"), "a").close()
+
+    script = os.path.join(rootfs, "rcS_shootout_" + name)
+
+    with open(script, "w") as f:
+        f.write("uorb start\n")
+
+        for command in commands:
+            f.write(command + "\n")
+
+        f.write("sleep 0.2\n")
+        f.write("ekf2_replay start %s -r\n" % REPLAY_LOG)
+
+    proc = subprocess.Popen(["./mainapp", os.path.relpath(script, posix_dir)], cwd=posix_dir,
+                            stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+
+    result = {"perf": {}, "output": []}
+    done = threading.Event()
+
+    def reader():
+        for line in iter(proc.stdout.readline, ""):
+            result["output"].append(line)
+            match = re.search(r"(\S+): (\d+) events(?:, \d+ overruns, \d+us elapsed, (\d+)us avg, "
+                              r"min (\d+)us max (\d+)us)?", line)
+
+            if match:
+                result["perf"][match.group(1)] = [int(v) if v else None for v in match.groups()[1:]]
+
+                if match.group(1) == PERF_DONE and not done.is_set():
+                    # sample before shutting down, the tasks are still there
+                    result["times"] = thread_times(proc.pid)
+                    result["memory"] = memory(proc.pid)
+                    done.set()
+
+    thread = threading.Thread(target=reader)
+    thread.daemon = True
+    thread.start()
+
+    if not done.wait(timeout):
+        print("%s: replay did not finish within %d s" % (name, timeout), file=sys.stderr)
+
+    try:
+        proc.stdin.write("perf\nshutdown\n")
+        proc.stdin.flush()
+
+    except IOError:
+        pass
+
+    end = time.time() + 10
+
+    while proc.poll() is None and time.time() < end:
+        time.sleep(0.1)
+
+    if proc.poll() is None:
+        proc.kill()
+
+    thread.join(1)
+    os.remove(script)
+
+    replayed = os.path.join(rootfs, REPLAYED_LOG)
+    result["log"] = replayed if os.path.exists(replayed) else None
+    return result
+
+
+def nearest(times, samples, t, max_dt):
+    i = bisect.bisect_left(times, t)
+    best = None
+
+    for j in (i - 1, i):
+        if 0 <= j < len(times) and abs(times[j] - t) <= max_dt:
+            if best is None or abs(times[j] - t) < abs(times[best] - t):
+                best = j
+
+    return samples[best][1] if best is not None else None
+
+
+def statistics(errors):
+    if len(errors) == 0:
+        return None
+
+    return math.sqrt(sum(e * e for e in errors) / len(errors)), max(errors)
+
+
+def attitude_errors(est, ref, t_start):
+    """Rotation angle between estimated and reference attitude in deg"""
+    times = [t for t, _ in ref]
+    errors = []
+
+    for t, att in est:
+        if t < t_start:
+            continue
+
+        r = nearest(times, ref, t, 0.1)
+
+        if r is None:
+            continue
+
+        dot = abs(att["qw"] * r["qw"] + att["qx"] * r["qx"] + att["qy"] * r["qy"] + att["qz"] * r["qz"])
+        errors.append(math.degrees(2.0 * math.acos(min(dot, 1.0))))
+
+    return statistics(errors)
+
+
+def position_errors(est, gps, t_start):
+    """Horizontal and vertical error against gps in m, both in a local frame
+    around the first gps fix since the estimators choose their own origin"""
+    gps = [(t, g) for t, g in gps if g["Fix"] >= 3]
+
+    if len(gps) == 0:
+        return None, None
+
+    lat0 = gps[0][1]["Lat"]
+    lon0 = gps[0][1]["Lon"]
+    cos_lat0 = math.cos(math.radians(lat0))
+    times = [t for t, _ in gps]
+    errors_xy = []
+    errors_z = []
+
+    for t, lpos in est:
+        # position relative to the reference of the estimator, skip until it has one
+        if t < t_start or not (lpos["PFlg"] & 1) or lpos["RLat"] == 0:
+            continue
+
+        g = nearest(times, gps, t, 0.2)
+
+        if g is None:
+            continue
+
+        dn = math.radians(lpos["RLat"] - g["Lat"]) * EARTH_RADIUS + lpos["X"]
+        de = math.radians(lpos["RLon"] - g["Lon"]) * EARTH_RADIUS * cos_lat0 + lpos["Y"]
+        errors_xy.append(math.sqrt(dn * dn + de * de))
+
+        if lpos["PFlg"] & 2:
+            errors_z.append(abs(lpos["RAlt"] - lpos["Z"] - g["Alt"]))
+
+    return statistics(errors_xy), statistics(errors_z)
+
+
+def format_stat(stat, unit):
+    if stat is None:
+        return "-"
+
+    return "%.2f / %.2f %s" % (stat[0], stat[1], unit)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the estimators on the same replay log")
+    parser.add_argument("logfile", help="log with ekf2 replay messages")
+    parser.add_argument("-b", "--build", default="build_posix_sitl_replay",
+                        help="posix_sitl_replay build directory")
+    parser.add_argument("-e", "--estimator", action="append",
+                        help="configuration to run, all if not given: %s" %
+                        ", ".join(name for name, _ in CONFIGS))
+    parser.add_argument("-r", "--reference", help="log with the reference ATT and GPS messages")
+    parser.add_argument("-s", "--skip", type=float, default=10.0,
+                        help="seconds at the start of the log excluded from the errors")
+    parser.add_argument("-o", "--output", default="shootout",
+                        help="directory for the report and the replayed logs")
+    parser.add_argument("-t", "--timeout", type=int, default=3600,
+                        help="maximum replay time per configuration in s")
+    args = parser.parse_args()
+
+    configs = [(name, commands) for name, commands in CONFIGS
+               if args.estimator is None or name in args.estimator]
+
+    if len(configs) == 0:
+        print("no such configuration", file=sys.stderr)
+        return 1
+
+    posix_dir = os.path.join(args.build, "src", "firmware", "posix")
+
+    if not os.path.exists(os.path.join(posix_dir, "mainapp")):
+        print("%s not found, run make posix_sitl_replay first" % posix_dir, file=sys.stderr)
+        return 1
+
+    if not os.path.exists(args.output):
+        os.makedirs(args.output)
+
+    reference = LogReader(args.reference or args.logfile).read(["ATT", "GPS"])
+    t_start = (reference["ATT"][0][0] if len(reference["ATT"]) > 0 else 0.0) + args.skip
+    rows = []
+
+    for name, commands in configs:
+        print("replaying %s ..." % name)
+        result = run_config(os.path.abspath(posix_dir), args.logfile, name, commands, args.timeout)
+
+        # console output of the run, for the perf counters of the estimators themselves
+        with open(os.path.join(args.output, name + ".txt"), "w") as f:
+            f.writelines(result["output"])
+
+        if "times" not in result:
+            rows.append((name, ["failed"]))
+            continue
+
+        # cpu time of the estimator tasks per imu sample
+        replay_perf = result["perf"].get("ekf2_replay_estimator", [0, None, None, None])
+        samples = replay_perf[0]
+        tasks = set(TASK_NAMES[c.split()[0]] for c in commands)
+        cpu = sum(result["times"].get(task, 0.0) for task in tasks)
+        cpu_per_sample = cpu / samples * 1e6 if samples > 0 else 0.0
+
+        att_err = None
+        xy_err = None
+        z_err = None
+
+        if result["log"] is not None:
+            log = os.path.join(args.output, name + ".px4log")
+            shutil.move(result["log"], log)
+            est = LogReader(log).read(["ATT", "LPOS"])
+            att_err = attitude_errors(est["ATT"], reference["ATT"], t_start)
+            xy_err, z_err = position_errors(est["LPOS"], reference["GPS"], t_start)
+
+        rows.append((name, [
+            "%d" % samples,
+            "%.1f us" % cpu_per_sample,
+            "%s us" % replay_perf[1] if replay_perf[1] is not None else "-",
+            "%d kB" % result["memory"][0],
+            format_stat(att_err, "deg"),
+            format_stat(xy_err, "m"),
+            format_stat(z_err, "m"),
+        ]))
+
+    header = ["estimator", "samples", "cpu/sample", "latency avg", "peak rss",
+              "att err rms/max", "hor err rms/max", "vert err rms/max"]
+    widths = [len(h) for h in header]
+
+    for name, values in rows:
+        for i, v in enumerate([name] + values):
+            widths[i] = max(widths[i], len(v))
+
+    lines = ["log: %s" % args.logfile,
+             "reference: %s, errors from %.1f s" % (args.reference or args.logfile, t_start),
+             "",
+             "  ".join(h.ljust(w) for h, w in zip(header, widths)).rstrip()]
+
+    for name, values in rows:
+        lines.append("  ".join(v.ljust(w) for v, w in zip([name] + values, widths)).rstrip())
+
+    report = "\n".join(lines) + "\n"
+    print()
+    print(report, end="")
+
+    with open(os.path.join(args.output, "report.txt"), "w") as f:
+        f.write(report)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -13,6 +13,54 @@ fp_src = open("px4_parameters.c", "w")
 tree = ET.parse(os.sys.argv[1])
 root = tree.getroot()
 
+def param_name_hash(seed, name):
+	# 32 bit FNV-1a, must match param_name_hash() in param.c
+	h = seed if seed else 0x811c9dc5
+	for c in bytearray(name.encode("ascii")):
+		h ^= c
+		h = (h * 16777619) & 0xffffffff
+	return h
+
+def generate_name_hash(names):
+	# Minimal perfect hash (hash and displace): names are distributed into
+	# buckets by their unseeded hash. Each bucket stores either the seed that
+	# maps all of its names to free slots or, for single names, the slot itself.
+	size = max(len(names), 1)
+	buckets = [[] for _ in range(size)]
+	for index, name in enumerate(names):
+		buckets[param_name_hash(0, name) % size].append(index)
+	displace = [0] * size
+	slots = [-1] * size
+	order = sorted(range(size), key=lambda b: len(buckets[b]), reverse=True)
+	for b in order:
+		bucket = buckets[b]
+		if len(bucket) <= 1:
+			break
+		seed = 1
+		item = 0
+		taken = []
+		while item < len(bucket):
+			slot = param_name_hash(seed, names[bucket[item]]) % size
+			if slots[slot] != -1 or slot in taken:
+				seed += 1
+				item = 0
+				taken = []
+			else:
+				taken.append(slot)
+				item += 1
+		if seed > 32767:
+			raise SystemExit("Error in %s: parameter name hash seed out of range" % os.sys.argv[0])
+		displace[b] = seed
+		for index, slot in zip(bucket, taken):
+			slots[slot] = index
+	free = [s for s in range(size) if slots[s] == -1]
+	for b in order:
+		if len(buckets[b]) == 1:
+			slot = free.pop()
+			displace[b] = -slot - 1
+			slots[slot] = buckets[b][0]
+	return displace, [max(s, 0) for s in slots]
+
 # Generate the header file content
 header = """
 #include <stdint.h>
@@ -61,6 +109,7 @@ __attribute__((used, section("__param")))
 struct px4_parameters_t px4_parameters = {
 """
 i=0
+names = []
 for group in root:
 	if group.tag == "group" and "no_code_generation" not in group.attrib:
 
@@ -78,6 +127,7 @@ for group in root:
 			elif (param.attrib["type"] == "INT32"):
 				val_str = ".val.i = "
 			i+=1
+			names.append(param.attrib["name"])
 			src += """
 	{
 		"%s",
@@ -88,12 +138,33 @@ for group in root:
 src += """
 	%d
 };
+""" % i
+
+# Name lookup tables
+displace, slots = generate_name_hash(names)
+header += """
+/* minimal perfect hash of the parameter names, see param_find() */
+#define PX4_PARAMETERS_HASH_SIZE %d
+extern const int16_t px4_parameters_hash_displace[PX4_PARAMETERS_HASH_SIZE];
+extern const uint16_t px4_parameters_hash_index[PX4_PARAMETERS_HASH_SIZE];
+""" % len(slots)
+
+src += """
+const int16_t px4_parameters_hash_displace[PX4_PARAMETERS_HASH_SIZE] = {
+	%s
+};
+
+const uint16_t px4_parameters_hash_index[PX4_PARAMETERS_HASH_SIZE] = {
+	%s
+};
+""" % (",\n\t".join(str(d) for d in displace), ",\n\t".join(str(s) for s in slots))
 
+src += """
 //extern const struct px4_parameters_t px4_parameters;
 
 __END_DECLS
 
-""" % i
+"""
 
 fp_header.write(header)
 fp_src.write(src)
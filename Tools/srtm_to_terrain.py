@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Convert SRTM elevation tiles (.hgt) to the terrain tiles read by
+# lib/terrain_estimation/terrain_database.cpp. Copy the resulting .ter files
+# to the terrain directory on the SD card.
+#
+# usage: srtm_to_terrain.py [--step N] [--output DIR] N47E008.hgt ...
+#
+
+# for python2.7 compatibility
+from __future__ import print_function
+
+import argparse
+import array
+import os
+import re
+import struct
+import sys
+
+TILE_MAGIC = 0x54345850
+TILE_VERSION = 1
+TILE_VOID = -32768
+
+
+def convert(path, output, step):
+    name = os.path.splitext(os.path.basename(path))[0]
+    match = re.match(r'^([NS])(\d\d)([EW])(\d\d\d)$', name.upper())
+
+    if match is None:
+        raise ValueError("%s: not named like an SRTM tile, e.g. N47E008.hgt" % path)
+
+    lat = int(match.group(2)) * (1 if match.group(1) == 'N' else -1)
+    lon = int(match.group(4)) * (1 if match.group(3) == 'E' else -1)
+
+    samples = array.array('h')
+
+    with open(path, 'rb') as f:
+        samples.fromstring(f.read()) if sys.version_info[0] < 3 else samples.frombytes(f.read())
+
+    # SRTM is big endian
+    if sys.byteorder == 'little':
+        samples.byteswap()
+
+    size = int(round(len(samples) ** 0.5))
+
+    if size * size != len(samples) or (size - 1) % step != 0:
+        raise ValueError("%s: %d samples do not make a tile that can be reduced by %d" % (path, len(samples), step))
+
+    # SRTM rows go from north to south, the terrain tiles from south to north
+    out = array.array('h')
+
+    for row in range(size - 1, -1, -step):
+        out.extend(samples[row * size + col] for col in range(0, size, step))
+
+    count = (size - 1) // step + 1
+
+    if sys.byteorder != 'little':
+        out.byteswap()
+
+    out_path = os.path.join(output, "%s.ter" % name.upper())
+
+    with open(out_path, 'wb') as f:
+        f.write(struct.pack('<IHHhhHH', TILE_MAGIC, TILE_VERSION, 0, lat, lon, count, count))
+        f.write(out.tostring() if sys.version_info[0] < 3 else out.tobytes())
+
+    voids = sum(1 for v in out if v == TILE_VOID)
+    print("%s: %dx%d samples, %d voids" % (out_path, count, count, voids))
+
+
+parser = argparse.ArgumentParser(description="Convert SRTM tiles to terrain tiles")
+parser.add_argument('--step', type=int, default=1,
+                    help="keep every Nth sample, e.g. 3 turns 3 arc second tiles into 9 arc seconds")
+parser.add_argument('--output', default='.', help="output directory")
+parser.add_argument('tiles', nargs='+', help="SRTM .hgt files")
+args = parser.parse_args()
+
+for tile in args.tiles:
+    convert(tile, args.output, args.step)
@@ -14,8 +14,13 @@ set(config_module_list
 	modules/uORB
 	modules/param
 	modules/systemlib
+	modules/attitude_estimator_ekf
+	modules/attitude_estimator_q
 	modules/ekf2
 	modules/ekf2_replay
+	modules/ekf_att_pos_estimator
+	modules/local_position_estimator
+	modules/position_estimator_inav
 	modules/sdlog2
 	lib/controllib
 	lib/mathlib
@@ -25,6 +30,7 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/terrain_estimation
 	)
 
 set(config_extra_builtin_cmds
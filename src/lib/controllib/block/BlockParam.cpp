@@ -49,7 +49,9 @@ namespace control
 {
 
 BlockParamBase::BlockParamBase(Block *parent, const char *name, bool parent_prefix) :
-	_handle(PARAM_INVALID)
+	_handle(PARAM_INVALID),
+	_change_seq(0),
+	_stale(true)
 {
 	char fullname[blockNameLengthMax];
 
@@ -80,6 +82,21 @@ BlockParamBase::BlockParamBase(Block *parent, const char *name, bool parent_pref
 	}
 };
 
+bool BlockParamBase::fetch()
+{
+	if (_handle == PARAM_INVALID) {
+		return false;
+	}
+
+	if (!_stale && !param_changed_since(_handle, _change_seq)) {
+		return false;
+	}
+
+	_change_seq = param_change_seq();
+	_stale = false;
+	return true;
+}
+
 template <class T>
 BlockParam<T>::BlockParam(Block *block, const char *name,
 			  bool parent_prefix, T *extern_address) :
@@ -97,6 +114,7 @@ template <class T>
 void BlockParam<T>::set(T val)
 {
 	_val = val;
+	_stale = true;
 
 	if (_extern_address != NULL) {
 		*_extern_address = val;
@@ -106,7 +124,8 @@ void BlockParam<T>::set(T val)
 template <class T>
 void BlockParam<T>::update()
 {
-	if (_handle != PARAM_INVALID) {
+	/* only read parameters that changed, tuning one must not reload them all */
+	if (fetch()) {
 		param_get(_handle, &_val);
 
 		if (_extern_address != NULL) {
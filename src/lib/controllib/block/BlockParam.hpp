@@ -65,7 +65,16 @@ public:
 	virtual void update() = 0;
 	const char *getName() { return param_name(_handle); }
 protected:
+	/**
+	 * Check if the value needs to be fetched, because it was never
+	 * read, was overwritten locally or the parameter changed since.
+	 * Marks the value as fetched.
+	 */
+	bool fetch();
+
 	param_t _handle;
+	uint32_t _change_seq;	/**< parameter change sequence at the last fetch */
+	bool _stale;		/**< local value does not reflect the parameter */
 };
 
 /**
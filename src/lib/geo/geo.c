@@ -166,6 +166,50 @@ __EXPORT int map_projection_project(const struct map_projection_reference_s *ref
 	return 0;
 }
 
+__EXPORT int map_projection_project_batch(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, size_t n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	const double ref_sin_lat = ref->sin_lat;
+	const double ref_cos_lat = ref->cos_lat;
+	const double ref_lon_rad = ref->lon_rad;
+
+	for (size_t i = 0; i < n; i++) {
+		double lat_rad = lat[i] * M_DEG_TO_RAD;
+		double d_lon = lon[i] * M_DEG_TO_RAD - ref_lon_rad;
+
+		double sin_lat = sin(lat_rad);
+		double cos_lat = cos(lat_rad);
+		double sin_d_lon = sin(d_lon);
+		double cos_d_lon = cos(d_lon);
+
+		double cos_c = ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon;
+		double north = ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon;
+		double east = cos_lat * sin_d_lon;
+
+		/* (north, east) has the length sin(c), the projection scales it to c */
+		double sin_c = sqrt(north * north + east * east);
+		double k;
+
+		if (sin_c < 0.1 && cos_c > 0.0) {
+			/* c / sin(c) to well below float resolution within about 600 km of the reference */
+			double s2 = sin_c * sin_c;
+			k = 1.0 + s2 * (1.0 / 6.0 + s2 * (3.0 / 40.0 + s2 * (5.0 / 112.0)));
+
+		} else {
+			k = (sin_c < DBL_EPSILON) ? 1.0 : (atan2(sin_c, cos_c) / sin_c);
+		}
+
+		x[i] = k * north * CONSTANTS_RADIUS_OF_EARTH;
+		y[i] = k * east * CONSTANTS_RADIUS_OF_EARTH;
+	}
+
+	return 0;
+}
+
 __EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
 {
 	return map_projection_reproject(&mp_ref, x, y, lat, lon);
@@ -202,6 +246,40 @@ __EXPORT int map_projection_reproject(const struct map_projection_reference_s *r
 	return 0;
 }
 
+__EXPORT int map_projection_reproject_batch(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, size_t n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	const double ref_sin_lat = ref->sin_lat;
+	const double ref_cos_lat = ref->cos_lat;
+	const double ref_lat_rad = ref->lat_rad;
+	const double ref_lon_rad = ref->lon_rad;
+
+	for (size_t i = 0; i < n; i++) {
+		double x_rad = x[i] / (double)CONSTANTS_RADIUS_OF_EARTH;
+		double y_rad = y[i] / (double)CONSTANTS_RADIUS_OF_EARTH;
+		double c = sqrt(x_rad * x_rad + y_rad * y_rad);
+		double sin_c = sin(c);
+		double cos_c = cos(c);
+
+		double lat_rad = ref_lat_rad;
+		double lon_rad = ref_lon_rad;
+
+		if (c > DBL_EPSILON) {
+			lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
+			lon_rad = ref_lon_rad + atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c);
+		}
+
+		lat[i] = lat_rad * M_RAD_TO_DEG;
+		lon[i] = lon_rad * M_RAD_TO_DEG;
+	}
+
+	return 0;
+}
+
 __EXPORT int map_projection_global_getref(double *lat_0, double *lon_0)
 {
 	if (!map_projection_global_initialized()) {
@@ -297,6 +375,38 @@ __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, dou
 	return CONSTANTS_RADIUS_OF_EARTH * c;
 }
 
+__EXPORT void get_distance_to_next_waypoint_batch(double lat_now, double lon_now, const double *lat_next,
+		const double *lon_next, float *dist, size_t n)
+{
+	const double lat_now_rad = lat_now * M_DEG_TO_RAD;
+	const double lon_now_rad = lon_now * M_DEG_TO_RAD;
+	const double cos_lat_now = cos(lat_now_rad);
+
+	for (size_t i = 0; i < n; i++) {
+		double lat_next_rad = lat_next[i] * M_DEG_TO_RAD;
+
+		double sin_half_d_lat = sin((lat_next_rad - lat_now_rad) * 0.5);
+		double sin_half_d_lon = sin((lon_next[i] * M_DEG_TO_RAD - lon_now_rad) * 0.5);
+
+		double a = sin_half_d_lat * sin_half_d_lat + sin_half_d_lon * sin_half_d_lon * cos_lat_now * cos(lat_next_rad);
+
+		/* same as 2 * atan2(sqrt(a), sqrt(1 - a)) for a in [0, 1] */
+		double h = fmin(sqrt(a), 1.0);
+		double c;
+
+		if (h < 0.05) {
+			/* asin(h) to well below float resolution up to about 600 km */
+			double h2 = h * h;
+			c = h * (1.0 + h2 * (1.0 / 6.0 + h2 * (3.0 / 40.0 + h2 * (5.0 / 112.0))));
+
+		} else {
+			c = asin(h);
+		}
+
+		dist[i] = CONSTANTS_RADIUS_OF_EARTH * 2.0 * c;
+	}
+}
+
 __EXPORT void create_waypoint_from_line_and_dist(double lat_A, double lon_A, double lat_B, double lon_B, float dist,
 		double *lat_target, double *lon_target)
 {
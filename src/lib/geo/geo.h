@@ -50,6 +50,7 @@ __BEGIN_DECLS
 #include "geo_lookup/geo_mag_declination.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #define CONSTANTS_ONE_G					9.80665f		/* m/s^2		*/
 #define CONSTANTS_AIR_DENSITY_SEA_LEVEL_15C		1.225f			/* kg/m^3		*/
@@ -195,6 +196,37 @@ __EXPORT int map_projection_global_reproject(float x, float y, double *lat, doub
 __EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
 				      double *lon);
 
+/**
+ * Transforms n points to the local azimuthal equidistant plane of the
+ * projection given by the argument, same as map_projection_project() per point.
+ *
+ * The terms of the reference are computed once for all points, use it wherever
+ * many points share one reference. Within about 600 km of the reference the
+ * scale of the projection is a short series, points further away take the
+ * exact and slower path.
+ *
+ * @param lat array of n latitudes in degrees
+ * @param lon array of n longitudes in degrees
+ * @param x array of n north coordinates, output
+ * @param y array of n east coordinates, output
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_batch(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, size_t n);
+
+/**
+ * Transforms n points in the local azimuthal equidistant plane to the geographic
+ * coordinate system, same as map_projection_reproject() per point.
+ *
+ * @param x array of n north coordinates
+ * @param y array of n east coordinates
+ * @param lat array of n latitudes in degrees, output
+ * @param lon array of n longitudes in degrees, output
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_reproject_batch(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, size_t n);
+
 /**
  * Get reference position of the global map projection
  */
@@ -236,6 +268,19 @@ __EXPORT int globallocalconverter_getref(double *lat_0, double *lon_0, float *al
  */
 __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
+/**
+ * Returns the distances from one position to n waypoints in meters, same as
+ * get_distance_to_next_waypoint() per waypoint.
+ *
+ * @param lat_now current position in degrees (47.1234567°, not 471234567°)
+ * @param lon_now current position in degrees (8.1234567°, not 81234567°)
+ * @param lat_next array of n waypoint latitudes in degrees
+ * @param lon_next array of n waypoint longitudes in degrees
+ * @param dist array of n distances, output
+ */
+__EXPORT void get_distance_to_next_waypoint_batch(double lat_now, double lon_now, const double *lat_next,
+		const double *lon_next, float *dist, size_t n);
+
 
 /**
  * Creates a new waypoint C on the line of two given waypoints (A, B) at certain distance
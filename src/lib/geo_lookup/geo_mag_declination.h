@@ -34,7 +34,8 @@
 /**
 * @file geo_mag_declination.h
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup table for earth magnetic field declination,
+* inclination and strength at sea level.
 *
 */
 
@@ -42,6 +43,31 @@
 
 __BEGIN_DECLS
 
+/**
+ * Magnetic declination in degrees, positive east of true north.
+ *
+ * @param lat latitude in degrees
+ * @param lon longitude in degrees
+ * @return declination, 0 for positions outside the valid range
+ */
 __EXPORT float get_mag_declination(float lat, float lon);
 
+/**
+ * Magnetic inclination in degrees, positive pointing down.
+ *
+ * @param lat latitude in degrees
+ * @param lon longitude in degrees
+ * @return inclination, 0 for positions outside the valid range
+ */
+__EXPORT float get_mag_inclination(float lat, float lon);
+
+/**
+ * Total magnetic field strength in Gauss.
+ *
+ * @param lat latitude in degrees
+ * @param lon longitude in degrees
+ * @return field strength, 0 for positions outside the valid range
+ */
+__EXPORT float get_mag_strength(float lat, float lon);
+
 __END_DECLS
@@ -0,0 +1,205 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Generate the magnetic field lookup tables from the World Magnetic Model
+# coefficients (WMM.COF as published by NOAA NGDC).
+#
+# usage: mag_tables.py WMM.COF [decimal year] > geo_mag_tables.generated.h
+#
+# The year defaults to the middle of the five year validity of the model.
+#
+
+# for python2.7 compatibility
+from __future__ import print_function
+
+import math
+import sys
+
+# grid, latitude spacing is what matters for accuracy towards the poles
+RES_LAT = 5
+RES_LON = 10
+MIN_LAT = -90
+MIN_LON = -180
+ROWS = 180 // RES_LAT + 1
+COLS = 360 // RES_LON + 1
+
+# WGS84 ellipsoid and geomagnetic reference radius, km
+WGS84_A = 6378.137
+WGS84_F = 1 / 298.257223563
+GEOMAG_R = 6371.2
+
+
+def load_coefficients(path):
+    epoch = None
+    coeffs = []
+
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+
+            if epoch is None:
+                epoch = float(fields[0])
+                continue
+
+            if fields[0].startswith('9999'):
+                break
+
+            coeffs.append((int(fields[0]), int(fields[1])) + tuple(float(v) for v in fields[2:6]))
+
+    return epoch, coeffs
+
+
+def legendre(nmax, x):
+    """Schmidt semi-normalized associated Legendre functions, p[n][m]"""
+    p = [[0.0] * (nmax + 1) for _ in range(nmax + 1)]
+    s = math.sqrt(max(0.0, 1.0 - x * x))
+
+    for m in range(nmax + 1):
+        pmm = 1.0
+
+        for k in range(1, m + 1):
+            pmm *= (2 * k - 1) * s
+
+        p[m][m] = pmm
+
+        if m + 1 <= nmax:
+            p[m + 1][m] = x * (2 * m + 1) * pmm
+
+        for n in range(m + 2, nmax + 1):
+            p[n][m] = ((2 * n - 1) * x * p[n - 1][m] - (n + m - 1) * p[n - 2][m]) / (n - m)
+
+    for n in range(nmax + 1):
+        for m in range(1, n + 1):
+            p[n][m] *= math.sqrt(2.0 * math.factorial(n - m) / math.factorial(n + m))
+
+    return p
+
+
+def field(epoch, coeffs, year, lat, lon):
+    """Declination and inclination in degrees and intensity in nT at sea level"""
+    # the horizontal components are undefined at the poles
+    lat = max(-89.999, min(89.999, lat))
+
+    e2 = WGS84_F * (2 - WGS84_F)
+    phi = math.radians(lat)
+    lam = math.radians(lon)
+
+    # geodetic to geocentric
+    rc = WGS84_A / math.sqrt(1 - e2 * math.sin(phi) ** 2)
+    p = rc * math.cos(phi)
+    z = rc * (1 - e2) * math.sin(phi)
+    r = math.hypot(p, z)
+    phic = math.asin(z / r)
+
+    nmax = max(c[0] for c in coeffs)
+    h = 1e-6
+    leg = legendre(nmax, math.sin(phic))
+    leg_p = legendre(nmax, math.sin(phic + h))
+    leg_m = legendre(nmax, math.sin(phic - h))
+
+    bx = 0.0
+    by = 0.0
+    bz = 0.0
+
+    for n, m, g, hc, g_dot, h_dot in coeffs:
+        g += g_dot * (year - epoch)
+        hc += h_dot * (year - epoch)
+        ar = (GEOMAG_R / r) ** (n + 2)
+        gh = g * math.cos(m * lam) + hc * math.sin(m * lam)
+        d_leg = (leg_p[n][m] - leg_m[n][m]) / (2 * h)
+
+        bx -= ar * gh * d_leg
+        by += ar * m * (g * math.sin(m * lam) - hc * math.cos(m * lam)) * leg[n][m]
+        bz -= (n + 1) * ar * gh * leg[n][m]
+
+    by /= math.cos(phic)
+
+    # back to the geodetic frame
+    psi = phic - phi
+    north = bx * math.cos(psi) - bz * math.sin(psi)
+    down = bx * math.sin(psi) + bz * math.cos(psi)
+    horizontal = math.hypot(north, by)
+
+    return (math.degrees(math.atan2(by, north)),
+            math.degrees(math.atan2(down, horizontal)),
+            math.hypot(horizontal, down))
+
+
+def print_table(name, comment, values):
+    print("/* %s */" % comment)
+    print("static const int16_t %s[%d][%d] = {" % (name, ROWS, COLS))
+
+    for row in values:
+        print("\t{ %s }," % ", ".join("%d" % v for v in row))
+
+    print("};")
+    print("")
+
+
+if len(sys.argv) < 2:
+    print("usage: mag_tables.py WMM.COF [decimal year]", file=sys.stderr)
+    sys.exit(1)
+
+epoch, coeffs = load_coefficients(sys.argv[1])
+year = float(sys.argv[2]) if len(sys.argv) > 2 else epoch + 2.5
+
+declination = []
+inclination = []
+intensity = []
+
+for i in range(ROWS):
+    lat = MIN_LAT + i * RES_LAT
+    values = [field(epoch, coeffs, year, lat, MIN_LON + j * RES_LON) for j in range(COLS)]
+    declination.append([int(round(v[0] * 100)) for v in values])
+    inclination.append([int(round(v[1] * 100)) for v in values])
+    intensity.append([int(round(v[2] / 10)) for v in values])
+
+print("/*")
+print("* This file is automatically generated by mag_tables.py - do not edit.")
+print("* World Magnetic Model epoch %.1f evaluated for %.1f at sea level." % (epoch, year))
+print("*/")
+print("")
+print("#pragma once")
+print("")
+print("#define MAG_TABLE_RES_LAT\t%d" % RES_LAT)
+print("#define MAG_TABLE_RES_LON\t%d" % RES_LON)
+print("#define MAG_TABLE_MIN_LAT\t%d" % MIN_LAT)
+print("#define MAG_TABLE_MIN_LON\t%d" % MIN_LON)
+print("#define MAG_TABLE_ROWS\t\t%d" % ROWS)
+print("#define MAG_TABLE_COLS\t\t%d" % COLS)
+print("")
+print_table("declination_table", "declination in 0.01 degrees, positive east", declination)
+print_table("inclination_table", "inclination in 0.01 degrees, positive down", inclination)
+print_table("intensity_table", "total intensity in 10 nT", intensity)
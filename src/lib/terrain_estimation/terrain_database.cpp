@@ -0,0 +1,336 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file terrain_database.cpp
+ * Terrain elevation from tiles on the SD card.
+ */
+
+#include "terrain_database.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __PX4_POSIX
+#include <sys/mman.h>
+#endif
+
+#include <geo/geo.h>
+
+/* upper bound on the samples of one leg, longer legs are sampled more sparsely */
+#define CLEARANCE_MAX_SAMPLES	5000
+
+TerrainDatabase::TerrainDatabase(const char *directory) :
+	_directory(directory),
+	_tiles{},
+	_clock(0),
+	_cell_tile(nullptr),
+	_cell_row(0),
+	_cell_col(0),
+	_cell{}
+{
+	for (unsigned i = 0; i < MAX_TILES; i++) {
+		_tiles[i].fd = -1;
+	}
+}
+
+TerrainDatabase::~TerrainDatabase()
+{
+	close();
+}
+
+void
+TerrainDatabase::close()
+{
+	for (unsigned i = 0; i < MAX_TILES; i++) {
+		close_tile(&_tiles[i]);
+	}
+}
+
+void
+TerrainDatabase::close_tile(tile_s *tile)
+{
+	if (_cell_tile == tile) {
+		_cell_tile = nullptr;
+	}
+
+#ifdef __PX4_POSIX
+
+	if (tile->mapping != nullptr) {
+		munmap(tile->mapping, tile->map_size);
+	}
+
+#endif
+
+	if (tile->fd >= 0) {
+		::close(tile->fd);
+	}
+
+	tile->used = false;
+	tile->fd = -1;
+	tile->data = nullptr;
+	tile->mapping = nullptr;
+	tile->map_size = 0;
+}
+
+void
+TerrainDatabase::open_tile(tile_s *tile)
+{
+	char path[80];
+	snprintf(path, sizeof(path), "%s/%c%02d%c%03d.ter", _directory,
+		 tile->lat >= 0 ? 'N' : 'S', tile->lat >= 0 ? tile->lat : -tile->lat,
+		 tile->lon >= 0 ? 'E' : 'W', tile->lon >= 0 ? tile->lon : -tile->lon);
+
+	tile->fd = open(path, O_RDONLY);
+
+	if (tile->fd < 0) {
+		/* no tile, the slot remembers that until it is reused */
+		return;
+	}
+
+	struct terrain_tile_header_s header;
+	off_t size = lseek(tile->fd, 0, SEEK_END);
+
+	if (lseek(tile->fd, 0, SEEK_SET) != 0 ||
+	    read(tile->fd, &header, sizeof(header)) != sizeof(header) ||
+	    header.magic != TERRAIN_TILE_MAGIC || header.version != TERRAIN_TILE_VERSION ||
+	    header.lat != tile->lat || header.lon != tile->lon ||
+	    header.rows < 2 || header.cols < 2 ||
+	    size != (off_t)(sizeof(header) + (size_t)header.rows * header.cols * sizeof(int16_t))) {
+		PX4_WARN("invalid terrain tile %s", path);
+		::close(tile->fd);
+		tile->fd = -1;
+		return;
+	}
+
+	tile->rows = header.rows;
+	tile->cols = header.cols;
+
+#ifdef __PX4_POSIX
+
+	void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, tile->fd, 0);
+
+	if (mapping != MAP_FAILED) {
+		tile->mapping = mapping;
+		tile->map_size = size;
+		tile->data = (const int16_t *)((const uint8_t *)mapping + sizeof(header));
+	}
+
+#endif
+}
+
+TerrainDatabase::tile_s *
+TerrainDatabase::get_tile(int lat, int lon)
+{
+	tile_s *slot = nullptr;
+
+	for (unsigned i = 0; i < MAX_TILES; i++) {
+		tile_s *tile = &_tiles[i];
+
+		if (tile->used && tile->lat == lat && tile->lon == lon) {
+			tile->last_used = ++_clock;
+			return (tile->fd >= 0) ? tile : nullptr;
+		}
+
+		/* an empty slot, otherwise the least recently used one */
+		if (slot == nullptr || (slot->used && (!tile->used || tile->last_used < slot->last_used))) {
+			slot = tile;
+		}
+	}
+
+	close_tile(slot);
+	slot->lat = lat;
+	slot->lon = lon;
+	slot->used = true;
+	slot->last_used = ++_clock;
+	open_tile(slot);
+
+	return (slot->fd >= 0) ? slot : nullptr;
+}
+
+bool
+TerrainDatabase::read_cell(tile_s *tile, unsigned row, unsigned col)
+{
+	if (_cell_tile == tile && _cell_row == row && _cell_col == col) {
+		return true;
+	}
+
+	_cell_tile = nullptr;
+
+	if (tile->data != nullptr) {
+		_cell[0] = tile->data[row * tile->cols + col];
+		_cell[1] = tile->data[row * tile->cols + col + 1];
+		_cell[2] = tile->data[(row + 1) * tile->cols + col];
+		_cell[3] = tile->data[(row + 1) * tile->cols + col + 1];
+
+	} else {
+		for (unsigned i = 0; i < 2; i++) {
+			off_t offset = sizeof(struct terrain_tile_header_s) + ((row + i) * tile->cols + col) * sizeof(int16_t);
+
+			if (lseek(tile->fd, offset, SEEK_SET) != offset ||
+			    read(tile->fd, &_cell[2 * i], 2 * sizeof(int16_t)) != 2 * sizeof(int16_t)) {
+				return false;
+			}
+		}
+	}
+
+	_cell_tile = tile;
+	_cell_row = row;
+	_cell_col = col;
+
+	return true;
+}
+
+bool
+TerrainDatabase::elevation(double lat, double lon, float &elevation)
+{
+	if (!(lat >= -90.0 && lat < 90.0 && lon >= -180.0 && lon < 180.0)) {
+		return false;
+	}
+
+	tile_s *tile = get_tile((int)floor(lat), (int)floor(lon));
+
+	if (tile == nullptr) {
+		return false;
+	}
+
+	/* position in samples from the south west corner */
+	float y = (float)((lat - tile->lat) * (tile->rows - 1));
+	float x = (float)((lon - tile->lon) * (tile->cols - 1));
+
+	unsigned row = (unsigned)y;
+	unsigned col = (unsigned)x;
+
+	/* the north and east edges are the last row and column */
+	row = (row > (unsigned)tile->rows - 2) ? tile->rows - 2 : row;
+	col = (col > (unsigned)tile->cols - 2) ? tile->cols - 2 : col;
+
+	if (!read_cell(tile, row, col)) {
+		return false;
+	}
+
+	if (_cell[0] == TERRAIN_TILE_VOID || _cell[1] == TERRAIN_TILE_VOID ||
+	    _cell[2] == TERRAIN_TILE_VOID || _cell[3] == TERRAIN_TILE_VOID) {
+		return false;
+	}
+
+	float x_frac = x - col;
+	float y_frac = y - row;
+
+	float south = _cell[0] + x_frac * (_cell[1] - _cell[0]);
+	float north = _cell[2] + x_frac * (_cell[3] - _cell[2]);
+
+	elevation = south + y_frac * (north - south);
+
+	return true;
+}
+
+bool
+TerrainDatabase::read_block(double lat, double lon, unsigned size, int16_t *samples, struct terrain_block_s &block)
+{
+	if (!(lat >= -90.0 && lat < 90.0 && lon >= -180.0 && lon < 180.0)) {
+		return false;
+	}
+
+	tile_s *tile = get_tile((int)floor(lat), (int)floor(lon));
+
+	if (tile == nullptr || tile->rows < size || tile->cols < size) {
+		return false;
+	}
+
+	/* centered on the position, but within the tile */
+	int row = (int)((lat - tile->lat) * (tile->rows - 1)) - (int)size / 2;
+	int col = (int)((lon - tile->lon) * (tile->cols - 1)) - (int)size / 2;
+
+	row = (row < 0) ? 0 : ((row > tile->rows - (int)size) ? tile->rows - size : row);
+	col = (col < 0) ? 0 : ((col > tile->cols - (int)size) ? tile->cols - size : col);
+
+	for (unsigned i = 0; i < size; i++) {
+		unsigned start = (row + i) * tile->cols + col;
+
+		if (tile->data != nullptr) {
+			memcpy(&samples[i * size], &tile->data[start], size * sizeof(int16_t));
+
+		} else {
+			off_t offset = sizeof(struct terrain_tile_header_s) + start * sizeof(int16_t);
+
+			if (lseek(tile->fd, offset, SEEK_SET) != offset ||
+			    read(tile->fd, &samples[i * size], size * sizeof(int16_t)) != (ssize_t)(size * sizeof(int16_t))) {
+				return false;
+			}
+		}
+	}
+
+	block.lat = tile->lat;
+	block.lon = tile->lon;
+	block.rows = tile->rows;
+	block.cols = tile->cols;
+	block.row = row;
+	block.col = col;
+
+	return true;
+}
+
+bool
+TerrainDatabase::min_clearance(double lat_start, double lon_start, float alt_start,
+			       double lat_end, double lon_end, float alt_end, float &clearance, float spacing)
+{
+	float distance = get_distance_to_next_waypoint(lat_start, lon_start, lat_end, lon_end);
+	unsigned steps = (spacing > 0.0f) ? (unsigned)(distance / spacing) + 1 : 1;
+
+	if (steps > CLEARANCE_MAX_SAMPLES) {
+		steps = CLEARANCE_MAX_SAMPLES;
+	}
+
+	clearance = INFINITY;
+
+	for (unsigned i = 0; i <= steps; i++) {
+		float t = (float)i / steps;
+		float terrain;
+
+		if (!elevation(lat_start + t * (lat_end - lat_start), lon_start + t * (lon_end - lon_start), terrain)) {
+			return false;
+		}
+
+		float height = alt_start + t * (alt_end - alt_start) - terrain;
+
+		if (height < clearance) {
+			clearance = height;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file terrain_database.h
+ * Terrain elevation from tiles on the SD card.
+ */
+
+#pragma once
+
+#include <px4_defines.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define TERRAIN_TILE_MAGIC	0x54345850	/**< "PX4T" */
+#define TERRAIN_TILE_VERSION	1
+#define TERRAIN_TILE_VOID	-32768		/**< sample without data */
+
+/**
+ * Header of a tile file, followed by rows * cols int16 elevations in meters
+ * above mean sea level, row by row from the south west corner. Everything is
+ * little endian.
+ *
+ * A tile covers one degree in latitude and longitude and is named after its
+ * south west corner like the SRTM tiles it is converted from, e.g. N47E008.ter.
+ * Tools/srtm_to_terrain.py does the conversion.
+ */
+struct terrain_tile_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	int16_t lat;		/**< south edge in degrees */
+	int16_t lon;		/**< west edge in degrees */
+	uint16_t rows;		/**< samples from the south to the north edge, both included */
+	uint16_t cols;		/**< samples from the west to the east edge, both included */
+};
+
+/**
+ * Position of a block of samples copied out of a tile.
+ */
+struct terrain_block_s {
+	int16_t lat;		/**< south edge of the tile in degrees */
+	int16_t lon;		/**< west edge of the tile in degrees */
+	uint16_t rows;		/**< samples of the tile from the south to the north edge */
+	uint16_t cols;		/**< samples of the tile from the west to the east edge */
+	uint16_t row;		/**< tile row of the south west sample of the block */
+	uint16_t col;		/**< tile column of the south west sample of the block */
+};
+
+/**
+ * Elevation lookup in a local directory of terrain tiles.
+ *
+ * Tiles are opened on demand and the least recently used one is closed
+ * when all slots are taken. On POSIX the tiles are mapped, on NuttX the
+ * four samples around a position are read from the file and kept until a
+ * query falls into another grid cell.
+ */
+class __EXPORT TerrainDatabase
+{
+public:
+	static constexpr unsigned MAX_TILES = 4;	/**< enough for a position at a tile corner */
+
+	TerrainDatabase(const char *directory = PX4_ROOTFSDIR"/fs/microsd/terrain");
+	~TerrainDatabase();
+
+	/**
+	 * Terrain elevation at a position, bilinearly interpolated.
+	 *
+	 * @param lat		Latitude in degrees.
+	 * @param lon		Longitude in degrees.
+	 * @param elevation	Set to the elevation in meters above mean sea level.
+	 * @return		false if there is no data for the position.
+	 */
+	bool elevation(double lat, double lon, float &elevation);
+
+	/**
+	 * Copy a square block of samples around a position.
+	 *
+	 * The block is moved inside the tile of the position where it would
+	 * extend beyond it.
+	 *
+	 * @param size		Samples per side of the block.
+	 * @param samples	Set to size * size samples, row by row from the south west corner.
+	 * @param block		Set to the tile and position of the block.
+	 * @return		false if there is no tile for the position or it is smaller than the block.
+	 */
+	bool read_block(double lat, double lon, unsigned size, int16_t *samples, struct terrain_block_s &block);
+
+	/**
+	 * Lowest height above the terrain on a straight leg.
+	 *
+	 * The altitude changes linearly from start to end, the terrain is
+	 * sampled at the given spacing.
+	 *
+	 * @param clearance	Set to the lowest altitude above the terrain in meters.
+	 * @param spacing	Distance between samples in meters.
+	 * @return		false if the terrain is not known for all of the leg.
+	 */
+	bool min_clearance(double lat_start, double lon_start, float alt_start,
+			   double lat_end, double lon_end, float alt_end, float &clearance, float spacing = 30.0f);
+
+	/**
+	 * Close all tiles, e.g. after a batch of queries.
+	 */
+	void close();
+
+private:
+	struct tile_s {
+		int16_t lat;
+		int16_t lon;
+		bool used;		/**< slot holds a tile or the knowledge that there is none */
+		int fd;			/**< -1 if there is no tile */
+		uint16_t rows;
+		uint16_t cols;
+		const int16_t *data;	/**< mapped samples */
+		void *mapping;
+		size_t map_size;
+		unsigned last_used;
+	};
+
+	const char *_directory;
+	tile_s _tiles[MAX_TILES];
+	unsigned _clock;
+
+	/* grid cell of the last lookup, saves the file reads where the tiles are not mapped */
+	tile_s *_cell_tile;
+	unsigned _cell_row;
+	unsigned _cell_col;
+	int16_t _cell[4];
+
+	tile_s *get_tile(int lat, int lon);
+	void open_tile(tile_s *tile);
+	void close_tile(tile_s *tile);
+	bool read_cell(tile_s *tile, unsigned row, unsigned col);
+
+	/* do not allow copying this class */
+	TerrainDatabase(const TerrainDatabase &);
+	TerrainDatabase &operator=(const TerrainDatabase &);
+};
@@ -39,12 +39,15 @@
 #include "terrain_estimator.h"
 
 #define DISTANCE_TIMEOUT 100000		// time in usec after which laser is considered dead
+#define DATABASE_TIMEOUT 1000000	// time in usec after which the terrain database estimate is considered stale
 
 TerrainEstimator::TerrainEstimator() :
 	_distance_last(0.0f),
 	_terrain_valid(false),
+	_terrain(),
 	_time_last_distance(0),
-	_time_last_gps(0)
+	_time_last_gps(0),
+	_time_last_database(0)
 {
 	memset(&_x._data[0], 0, sizeof(_x._data));
 	_u_z = 0.0f;
@@ -109,8 +112,10 @@ void TerrainEstimator::measurement_update(uint64_t time_ref, const struct vehicl
 		const struct distance_sensor_s *distance,
 		const struct vehicle_attitude_s *attitude)
 {
+	bool database_recent = _time_last_database > 0 && time_ref - _time_last_database < DATABASE_TIMEOUT;
+
 	// terrain estimate is invalid if we have range sensor timeout
-	if (time_ref - distance->timestamp > DISTANCE_TIMEOUT) {
+	if (time_ref - distance->timestamp > DISTANCE_TIMEOUT && !database_recent) {
 		_terrain_valid = false;
 	}
 
@@ -143,7 +148,7 @@ void TerrainEstimator::measurement_update(uint64_t time_ref, const struct vehicl
 		// if the current and the last range measurement are bad then we consider the terrain
 		// estimate to be invalid
 		if (!is_distance_valid(distance->current_distance) && !is_distance_valid(_distance_last)) {
-			_terrain_valid = false;
+			_terrain_valid = database_recent;
 
 		} else {
 			_terrain_valid = true;
@@ -172,6 +177,32 @@ void TerrainEstimator::measurement_update(uint64_t time_ref, const struct vehicl
 		_x += K * r;
 		_P -= K * C * _P;
 
+		// without a range measurement the terrain database gives the distance to the ground
+		float elevation;
+
+		if ((time_ref - distance->timestamp > DISTANCE_TIMEOUT || !is_distance_valid(distance->current_distance)) &&
+		    _terrain.elevation(gps->lat * 1e-7, gps->lon * 1e-7, elevation)) {
+			C.setZero();
+			C(0, 0) = -1;
+
+			// gps altitude error and the accuracy of the elevation data (about 5m)
+			R = gps->epv * gps->epv + 25.0f;
+
+			y(0) = gps->alt * 1e-3f - elevation;
+
+			S_I = (C * _P * C.transpose());
+			S_I(0, 0) += R;
+			S_I = matrix::inv<float, 1>(S_I);
+			r = y - C * _x;
+
+			K = _P * C.transpose() * S_I;
+			_x += K * r;
+			_P -= K * C * _P;
+
+			_terrain_valid = true;
+			_time_last_database = gps->timestamp_position;
+		}
+
 		_time_last_gps = gps->timestamp_position;
 	}
 
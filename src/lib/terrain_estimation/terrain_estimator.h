@@ -42,6 +42,8 @@
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/distance_sensor.h>
 
+#include "terrain_prefetch.h"
+
 
 /*
 * This class can be used to estimate distance to the ground using a laser range finder.
@@ -52,6 +54,9 @@
 * velocity measurements. Both functions should always be called together when there is new
 * acceleration data available.
 * The is_valid() function provides information whether the estimate is valid.
+* While the range finder has no valid reading, the elevation from the terrain database below
+* the gps position is used as a coarser measurement instead, if there are tiles for the area.
+* The tiles are read on the low priority work queue, measurement_update() only uses RAM.
 */
 
 class __EXPORT TerrainEstimator
@@ -76,6 +81,8 @@ private:
 	float _distance_last;
 	bool _terrain_valid;
 
+	TerrainPrefetch _terrain;	// elevation around the vehicle, loaded in the background
+
 	// kalman filter variables
 	matrix::Vector<float, n_x> _x;		// state: ground distance, velocity, accel bias in z direction
 	float  _u_z;			// acceleration in earth z direction
@@ -84,6 +91,7 @@ private:
 	// timestamps
 	uint64_t _time_last_distance;
 	uint64_t _time_last_gps;
+	uint64_t _time_last_database;
 
 	/*
 	struct {
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file terrain_prefetch.cpp
+ * Terrain elevation around the vehicle, kept in RAM for the estimators.
+ */
+
+#include "terrain_prefetch.h"
+
+#include <drivers/drv_hrt.h>
+#include <string.h>
+
+/* time in usec between requests while there is no block for the position, e.g. without tiles */
+#define PREFETCH_RETRY_INTERVAL	1000000
+
+TerrainPrefetch::TerrainPrefetch() :
+	_database(),
+	_blocks{},
+	_active(0),
+	_loading(false),
+	_request_lat(0.0),
+	_request_lon(0.0),
+	_last_request(0),
+	_work{}
+{
+}
+
+TerrainPrefetch::~TerrainPrefetch()
+{
+	work_cancel(LPWORK, &_work);
+}
+
+bool
+TerrainPrefetch::elevation(double lat, double lon, float &elevation)
+{
+	const block_s &block = _blocks[_active];
+	bool found = false;
+	bool near_edge = true;
+
+	if (block.valid) {
+		/* position in samples from the south west corner of the block */
+		float y = (float)((lat - block.position.lat) * (block.position.rows - 1)) - block.position.row;
+		float x = (float)((lon - block.position.lon) * (block.position.cols - 1)) - block.position.col;
+
+		if (y >= 0.0f && y <= BLOCK_SIZE - 1 && x >= 0.0f && x <= BLOCK_SIZE - 1) {
+			unsigned row = (unsigned)y;
+			unsigned col = (unsigned)x;
+
+			/* the north and east edges are the last row and column */
+			row = (row > BLOCK_SIZE - 2) ? BLOCK_SIZE - 2 : row;
+			col = (col > BLOCK_SIZE - 2) ? BLOCK_SIZE - 2 : col;
+
+			const int16_t *south = &block.samples[row * BLOCK_SIZE + col];
+			const int16_t *north = south + BLOCK_SIZE;
+
+			if (south[0] != TERRAIN_TILE_VOID && south[1] != TERRAIN_TILE_VOID &&
+			    north[0] != TERRAIN_TILE_VOID && north[1] != TERRAIN_TILE_VOID) {
+				float x_frac = x - col;
+				float y_frac = y - row;
+				float s = south[0] + x_frac * (south[1] - south[0]);
+				float n = north[0] + x_frac * (north[1] - north[0]);
+				elevation = s + y_frac * (n - s);
+				found = true;
+			}
+
+			/* a block at the edge of its tile cannot move further, the next tile is needed beyond it */
+			near_edge = (y < BLOCK_MARGIN && block.position.row > 0) ||
+				    (y > BLOCK_SIZE - 1 - BLOCK_MARGIN && block.position.row + BLOCK_SIZE < block.position.rows) ||
+				    (x < BLOCK_MARGIN && block.position.col > 0) ||
+				    (x > BLOCK_SIZE - 1 - BLOCK_MARGIN && block.position.col + BLOCK_SIZE < block.position.cols);
+		}
+	}
+
+	if (near_edge && !_loading && hrt_elapsed_time(&_last_request) > PREFETCH_RETRY_INTERVAL) {
+		_request_lat = lat;
+		_request_lon = lon;
+		_last_request = hrt_absolute_time();
+		_loading = true;
+		work_queue(LPWORK, &_work, (worker_t)&TerrainPrefetch::cycle_trampoline, this, 0);
+	}
+
+	return found;
+}
+
+void
+TerrainPrefetch::cycle_trampoline(void *arg)
+{
+	TerrainPrefetch *dev = reinterpret_cast<TerrainPrefetch *>(arg);
+
+	dev->cycle();
+}
+
+void
+TerrainPrefetch::cycle()
+{
+	/* elevation() does not read the inactive block */
+	block_s &block = _blocks[_active ^ 1];
+
+	block.valid = _database.read_block(_request_lat, _request_lon, BLOCK_SIZE, block.samples, block.position);
+
+	if (block.valid) {
+		/* the samples have to be complete before the block is used */
+		__sync_synchronize();
+		_active ^= 1;
+	}
+
+	/* the tiles stay open for the next block */
+	_loading = false;
+}
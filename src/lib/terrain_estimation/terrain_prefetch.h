@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file terrain_prefetch.h
+ * Terrain elevation around the vehicle, kept in RAM for the estimators.
+ */
+
+#pragma once
+
+#include <px4_workqueue.h>
+#include <stdint.h>
+
+#include "terrain_database.h"
+
+/**
+ * Block of terrain samples around the vehicle, loaded from the terrain
+ * database on the low priority work queue.
+ *
+ * elevation() only reads RAM, so it can be called from estimator loops. It
+ * requests a new block when the position gets close to the edge of the
+ * current one. The block is loaded into a second buffer which replaces the
+ * current one when it is complete.
+ */
+class __EXPORT TerrainPrefetch
+{
+public:
+	static constexpr unsigned BLOCK_SIZE = 16;	/**< samples per side, about 1.4 km with 3" tiles */
+	static constexpr unsigned BLOCK_MARGIN = 4;	/**< samples to the edge that trigger a new block */
+
+	TerrainPrefetch();
+	~TerrainPrefetch();
+
+	/**
+	 * Terrain elevation at a position from the block in RAM, bilinearly interpolated.
+	 *
+	 * @param lat		Latitude in degrees.
+	 * @param lon		Longitude in degrees.
+	 * @param elevation	Set to the elevation in meters above mean sea level.
+	 * @return		false if the position is not covered yet or there is no data for it.
+	 */
+	bool elevation(double lat, double lon, float &elevation);
+
+private:
+	struct block_s {
+		bool valid;
+		struct terrain_block_s position;
+		int16_t samples[BLOCK_SIZE * BLOCK_SIZE];
+	};
+
+	TerrainDatabase _database;		/**< only used on the work queue */
+
+	block_s _blocks[2];
+	volatile unsigned _active;		/**< block read by elevation(), the other one is loaded */
+	volatile bool _loading;			/**< a block is being loaded */
+
+	double _request_lat;
+	double _request_lon;
+	uint64_t _last_request;
+
+	struct work_s _work;
+
+	static void cycle_trampoline(void *arg);
+	void cycle();
+
+	/* do not allow copying this class */
+	TerrainPrefetch(const TerrainPrefetch &);
+	TerrainPrefetch &operator=(const TerrainPrefetch &);
+};
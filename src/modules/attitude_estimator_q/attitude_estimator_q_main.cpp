@@ -117,6 +117,7 @@ public:
 
 private:
 	static constexpr float _dt_max = 0.02;
+	static constexpr float _corr_dt_max = 0.1f;		/**< longest interval between two correction steps */
 	bool		_task_should_exit = false;		/**< if true, task should exit */
 	int		_control_task = -1;			/**< task handle for task */
 
@@ -159,6 +160,14 @@ private:
 	Vector<3>	_accel;
 	Vector<3>	_mag;
 
+	Vector<3>	_delta_angle;			/**< delta angle of the best gyro (rad) */
+	float		_delta_angle_dt = 0.0f;		/**< integration time of _delta_angle, zero if the rates have to be integrated (s) */
+	hrt_abstime	_gyro_timestamp = 0;		/**< timestamp of the last gyro sample used for prediction */
+	hrt_abstime	_accel_timestamp = 0;		/**< timestamp of the last accel sample used for correction */
+	float		_corr_dt = 0.0f;		/**< time since the previous correction (s) */
+	bool		_gyro_updated = false;
+	bool		_accel_updated = false;
+
 	vision_position_estimate_s _vision = {};
 	Vector<3>	_vision_hdg;
 
@@ -205,6 +214,20 @@ private:
 
 	bool update(float dt);
 
+	/**
+	 * Propagate the attitude by the delta angle of the best gyro.
+	 *
+	 * @param dt	time since the last update, used if the gyro provides no integral
+	 */
+	void predict(float dt);
+
+	/**
+	 * Correct the attitude and gyro bias using accel, mag and external heading.
+	 *
+	 * @param dt	time since the last correction
+	 */
+	void correct(float dt);
+
 	// Update magnetic declination (in rads) immediately changing yaw rotation
 	void update_mag_declination(float new_declination);
 };
@@ -399,6 +422,36 @@ void AttitudeEstimatorQ::task_main()
 				continue;
 			}
 
+			// Predict with every new delta angle of the best gyro, gated on its own timestamp.
+			// The delta angle covers the time since its previous sample. That is the whole time
+			// only for the gyro that triggers the sensor_combined publication, the samples other
+			// instances produce between two publications are not in the topic.
+			if (sensors.gyro_timestamp[best_gyro] != _gyro_timestamp) {
+				_gyro_timestamp = sensors.gyro_timestamp[best_gyro];
+				_gyro_updated = true;
+
+				if (sensors.gyro_integral_dt[best_gyro] > 0) {
+					_delta_angle.set(&sensors.gyro_integral_rad[best_gyro * 3]);
+					_delta_angle_dt = sensors.gyro_integral_dt[best_gyro] / 1e6f;
+
+				} else {
+					_delta_angle_dt = 0.0f;
+				}
+			}
+
+			// Correct with every new sample of the best accel
+			if (sensors.accelerometer_timestamp[best_accel] != _accel_timestamp) {
+				if (_accel_timestamp > 0 && sensors.accelerometer_timestamp[best_accel] > _accel_timestamp) {
+					_corr_dt = math::min((sensors.accelerometer_timestamp[best_accel] - _accel_timestamp) / 1e6f, _corr_dt_max);
+
+				} else {
+					_corr_dt = 0.0f;
+				}
+
+				_accel_timestamp = sensors.accelerometer_timestamp[best_accel];
+				_accel_updated = true;
+			}
+
 			_data_good = true;
 
 			if (!_failsafe) {
@@ -746,6 +799,62 @@ bool AttitudeEstimatorQ::update(float dt)
 
 	Quaternion q_last = _q;
 
+	if (_accel_updated) {
+		correct(_corr_dt);
+		_accel_updated = false;
+	}
+
+	if (_gyro_updated) {
+		predict(dt);
+		_gyro_updated = false;
+	}
+
+	_rates = _gyro + _gyro_bias;
+
+	if (!(PX4_ISFINITE(_q(0)) && PX4_ISFINITE(_q(1)) &&
+	      PX4_ISFINITE(_q(2)) && PX4_ISFINITE(_q(3)))) {
+		// Reset quaternion to last good state
+		_q = q_last;
+		_rates.zero();
+		_gyro_bias.zero();
+		return false;
+	}
+
+	return true;
+}
+
+void AttitudeEstimatorQ::predict(float dt)
+{
+	Vector<3> delta_angle;
+
+	if (_delta_angle_dt > 0.0f) {
+		// The drivers integrate at the full sensor rate with coning compensation,
+		// so the integral is the rotation vector over the whole interval. Adding
+		// another coning term between successive integrals would count it twice.
+		delta_angle = _delta_angle + _gyro_bias * _delta_angle_dt;
+
+	} else {
+		// No integral available, integrate the rates
+		delta_angle = (_gyro + _gyro_bias) * dt;
+	}
+
+	// Rotate by the rotation vector
+	float angle = delta_angle.length();
+	Quaternion dq(1.0f, 0.5f * delta_angle(0), 0.5f * delta_angle(1), 0.5f * delta_angle(2));
+
+	if (angle > 1e-6f) {
+		float s = sinf(0.5f * angle) / angle;
+		dq = Quaternion(cosf(0.5f * angle), delta_angle(0) * s, delta_angle(1) * s, delta_angle(2) * s);
+	}
+
+	_q = _q * dq;
+
+	// Normalize quaternion
+	_q.normalize();
+}
+
+void AttitudeEstimatorQ::correct(float dt)
+{
 	// Angular rate of correction
 	Vector<3> corr;
 
@@ -799,27 +908,11 @@ bool AttitudeEstimatorQ::update(float dt)
 		_gyro_bias(i) = math::constrain(_gyro_bias(i), -_bias_max, _bias_max);
 	}
 
-	_rates = _gyro + _gyro_bias;
-
-	// Feed forward gyro
-	corr += _rates;
-
 	// Apply correction to state
 	_q += _q.derivative(corr) * dt;
 
 	// Normalize quaternion
 	_q.normalize();
-
-	if (!(PX4_ISFINITE(_q(0)) && PX4_ISFINITE(_q(1)) &&
-	      PX4_ISFINITE(_q(2)) && PX4_ISFINITE(_q(3)))) {
-		// Reset quaternion to last good state
-		_q = q_last;
-		_rates.zero();
-		_gyro_bias.zero();
-		return false;
-	}
-
-	return true;
 }
 
 void AttitudeEstimatorQ::update_mag_declination(float new_declination)
@@ -52,6 +52,13 @@
 #include <string.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+
+#ifdef __PX4_POSIX
+#include <sys/mman.h>
+#include <pthread.h>
+#endif
 
 #include "dataman.h"
 #include <systemlib/param/param.h>
@@ -70,6 +77,10 @@ __EXPORT int dm_clear(dm_item_t item);
 __EXPORT void dm_lock(dm_item_t item);
 __EXPORT void dm_unlock(dm_item_t item);
 __EXPORT int dm_restart(dm_reset_reason restart_type);
+__EXPORT int dm_flush(void);
+__EXPORT ssize_t dm_read_range(dm_item_t item, unsigned char index, unsigned items, void *buffer, size_t buflen);
+__EXPORT ssize_t dm_write_range(dm_item_t item, unsigned char index, unsigned items, dm_persitence_t persistence,
+				const void *buffer, size_t buflen);
 
 /** Types of function calls supported by the worker task */
 typedef enum {
@@ -77,6 +88,9 @@ typedef enum {
 	dm_read_func,
 	dm_clear_func,
 	dm_restart_func,
+	dm_flush_func,
+	dm_read_range_func,
+	dm_write_range_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -107,6 +121,14 @@ typedef struct {
 		struct {
 			dm_reset_reason reason;
 		} restart_params;
+		struct {
+			dm_item_t item;
+			unsigned char index;
+			unsigned items;
+			dm_persitence_t persistence;
+			void *buf;
+			size_t count;
+		} range_params;
 	};
 } work_q_item_t;
 
@@ -122,7 +144,8 @@ static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX,
-	DM_KEY_MISSION_STATE_MAX
+	DM_KEY_MISSION_STATE_MAX,
+	DM_KEY_COMPAT_MAX
 };
 
 /* Table of offset for index 0 of each item type */
@@ -132,6 +155,11 @@ static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 static px4_sem_t *g_item_locks[DM_KEY_NUM_KEYS];
 static px4_sem_t g_sys_state_mutex;
 
+#ifdef __PX4_POSIX
+/* Exclude reads on the caller threads while the worker modifies an item type */
+static pthread_rwlock_t g_item_rwlocks[DM_KEY_NUM_KEYS];
+#endif
+
 /* The data manager store file handle and file name */
 static int g_fd = -1, g_task_fd = -1;
 static const char *default_device_path = PX4_ROOTFSDIR"/fs/microsd/dataman";
@@ -157,6 +185,48 @@ static bool g_task_should_exit;	/**< if true, dataman task should exit */
 #define DM_SECTOR_HDR_SIZE 4	/* data manager per item header overhead */
 static const unsigned k_sector_size = DM_MAX_DATA_SIZE + DM_SECTOR_HDR_SIZE; /* total item sorage space */
 
+/* Size of the file in bytes, a multiple of k_sector_size */
+static unsigned g_file_size;
+
+#ifdef __PX4_NUTTX
+/* The whole file does not fit into RAM, only cache the most recently used sectors */
+#define DM_CACHE_SECTORS	16
+#else
+/* Cache the whole file, the file is mapped into memory if possible */
+#define DM_CACHE_SECTORS	0
+#endif
+
+/* Time in us a write may stay in the cache before it is flushed to the file */
+#define DM_FLUSH_DELAY	200000
+
+typedef struct {
+	int offset;		/**< file offset of the cached sector, -1 if the entry is unused */
+	uint32_t last_use;	/**< cache clock at the last access, for LRU replacement */
+	bool dirty;		/**< sector has not been written to the file yet */
+} dm_cache_entry_t;
+
+/* Write-back cache of the data manager file, only accessed by the worker thread */
+static struct {
+	dm_cache_entry_t *entries;
+	unsigned char *data;		/**< sector data, entry i is at i * k_sector_size */
+	unsigned size;			/**< number of entries */
+	bool direct;			/**< whole file cached, entry i holds sector i */
+	bool mapped;			/**< data is a shared mapping of the file */
+	bool unsynced;			/**< file written since the last fsync */
+	uint32_t clock;
+	unsigned dirty;			/**< number of dirty entries */
+	hrt_abstime flush_deadline;	/**< time by which the dirty entries have to be flushed */
+	unsigned hits;
+	unsigned misses;
+	unsigned flushes;
+	unsigned flushed_sectors;
+	unsigned flush_errors;
+} g_cache;
+
+static perf_counter_t g_read_perf;
+static perf_counter_t g_write_perf;
+static perf_counter_t g_flush_perf;
+
 static void init_q(work_q_t *q)
 {
 	sq_init(&(q->q));		/* Initialize the NuttX queue structure */
@@ -320,13 +390,343 @@ calculate_offset(dm_item_t item, unsigned char index)
  * The total size must not exceed k_sector_size
  */
 
+static int
+cache_init(void)
+{
+	unsigned sectors = g_file_size / k_sector_size;
+
+	g_cache.size = sectors;
+
+	if (DM_CACHE_SECTORS > 0 && DM_CACHE_SECTORS < sectors) {
+		g_cache.size = DM_CACHE_SECTORS;
+	}
+
+	g_cache.direct = (g_cache.size == sectors);
+	g_cache.mapped = false;
+	g_cache.entries = (dm_cache_entry_t *)malloc(g_cache.size * sizeof(dm_cache_entry_t));
+
+#ifdef __PX4_POSIX
+
+	/* The mapping takes the place of the cache, it has to cover the whole file */
+	if (g_cache.entries != NULL && g_cache.direct &&
+	    (lseek(g_task_fd, 0, SEEK_END) >= (off_t)g_file_size || ftruncate(g_task_fd, g_file_size) == 0)) {
+
+		void *mapping = mmap(NULL, g_file_size, PROT_READ | PROT_WRITE, MAP_SHARED, g_task_fd, 0);
+
+		if (mapping != MAP_FAILED) {
+			g_cache.data = (unsigned char *)mapping;
+			g_cache.mapped = true;
+
+		} else {
+			PX4_WARN("Could not map data manager file, caching it instead");
+		}
+	}
+
+#endif
+
+	if (!g_cache.mapped) {
+		g_cache.data = (unsigned char *)malloc(g_cache.size * k_sector_size);
+	}
+
+	if (g_cache.entries == NULL || g_cache.data == NULL) {
+		free(g_cache.entries);
+		free(g_cache.data);
+		g_cache.entries = NULL;
+		g_cache.data = NULL;
+		g_cache.size = 0;
+		return -1;
+	}
+
+	for (unsigned i = 0; i < g_cache.size; i++) {
+		/* every sector of a mapped file is present */
+		g_cache.entries[i].offset = g_cache.mapped ? (int)(i * k_sector_size) : -1;
+		g_cache.entries[i].last_use = 0;
+		g_cache.entries[i].dirty = false;
+	}
+
+	return 0;
+}
+
+static void
+cache_deinit(void)
+{
+#ifdef __PX4_POSIX
+
+	if (g_cache.mapped) {
+		munmap(g_cache.data, g_file_size);
+		g_cache.data = NULL;
+		g_cache.mapped = false;
+	}
+
+#endif
+
+	free(g_cache.entries);
+	free(g_cache.data);
+	g_cache.entries = NULL;
+	g_cache.data = NULL;
+	g_cache.size = 0;
+}
+
+static inline void
+lock_item_write(dm_item_t item)
+{
+#ifdef __PX4_POSIX
+	pthread_rwlock_wrlock(&g_item_rwlocks[item]);
+#endif
+}
+
+static inline void
+unlock_item_write(dm_item_t item)
+{
+#ifdef __PX4_POSIX
+	pthread_rwlock_unlock(&g_item_rwlocks[item]);
+#endif
+}
+
+static void
+lock_all_items_write(void)
+{
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		lock_item_write((dm_item_t)i);
+	}
+}
+
+static void
+unlock_all_items_write(void)
+{
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		unlock_item_write((dm_item_t)i);
+	}
+}
+
+static inline unsigned char *
+cache_data(int entry)
+{
+	return &g_cache.data[entry * k_sector_size];
+}
+
+static void
+cache_mark_dirty(int entry)
+{
+	if (!g_cache.entries[entry].dirty) {
+		g_cache.entries[entry].dirty = true;
+
+		/* the oldest unflushed write determines the deadline */
+		if (g_cache.dirty++ == 0) {
+			g_cache.flush_deadline = hrt_absolute_time() + DM_FLUSH_DELAY;
+		}
+	}
+}
+
+/* Write all dirty sectors to the file and make sure they reach the physical media */
+static int
+cache_flush(void)
+{
+	int result = 0;
+
+	if (g_cache.dirty == 0 && !g_cache.unsynced) {
+		return 0;
+	}
+
+	perf_begin(g_flush_perf);
+
+#ifdef __PX4_POSIX
+
+	if (g_cache.mapped) {
+		/* The kernel tracks the modified pages, sync all of them at once */
+		if (msync(g_cache.data, g_file_size, MS_SYNC) == 0) {
+			for (unsigned i = 0; i < g_cache.size; i++) {
+				if (g_cache.entries[i].dirty) {
+					g_cache.entries[i].dirty = false;
+					g_cache.flushed_sectors++;
+				}
+			}
+
+			g_cache.dirty = 0;
+
+		} else {
+			result = -1;
+		}
+	}
+
+#endif
+
+	for (unsigned i = 0; i < g_cache.size && !g_cache.mapped;) {
+		dm_cache_entry_t *entry = &g_cache.entries[i];
+
+		if (!entry->dirty) {
+			i++;
+			continue;
+		}
+
+		/* Coalesce dirty entries holding consecutive sectors into a single write */
+		unsigned run = 1;
+
+		while (i + run < g_cache.size && g_cache.entries[i + run].dirty &&
+		       g_cache.entries[i + run].offset == entry->offset + (int)(run * k_sector_size)) {
+			run++;
+		}
+
+		ssize_t count = run * k_sector_size;
+
+		if (lseek(g_task_fd, entry->offset, SEEK_SET) == entry->offset &&
+		    write(g_task_fd, cache_data(i), count) == count) {
+
+			for (unsigned j = i; j < i + run; j++) {
+				g_cache.entries[j].dirty = false;
+			}
+
+			g_cache.dirty -= run;
+			g_cache.flushed_sectors += run;
+			g_cache.unsynced = true;
+
+		} else {
+			/* keep the sectors dirty, they are retried with the next flush */
+			result = -1;
+		}
+
+		i += run;
+	}
+
+	/* One sync for the whole batch */
+	if (g_cache.unsynced) {
+		fsync(g_task_fd);
+		g_cache.unsynced = false;
+	}
+
+	if (g_cache.dirty > 0) {
+		g_cache.flush_errors++;
+		g_cache.flush_deadline = hrt_absolute_time() + DM_FLUSH_DELAY;
+	}
+
+	g_cache.flushes++;
+	perf_end(g_flush_perf);
+
+	return result;
+}
+
+/* Find the cache entry of a sector, -1 if it is not cached */
+static int
+cache_find(int offset)
+{
+	if (g_cache.direct) {
+		int entry = offset / k_sector_size;
+		return (g_cache.entries[entry].offset == offset) ? entry : -1;
+	}
+
+	for (unsigned i = 0; i < g_cache.size; i++) {
+		if (g_cache.entries[i].offset == offset) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Get the cache entry of a sector, replacing the least recently used one if it is not cached.
+ *
+ * @param fill	read the sector from the file on a miss, otherwise the sector is zeroed
+ * @return	entry index, -1 on failure
+ */
+static int
+cache_get(int offset, bool fill)
+{
+	int entry = cache_find(offset);
+
+	if (entry >= 0) {
+		g_cache.entries[entry].last_use = ++g_cache.clock;
+		g_cache.hits++;
+		return entry;
+	}
+
+	g_cache.misses++;
+
+	if (g_cache.direct) {
+		entry = offset / k_sector_size;
+
+	} else {
+		entry = 0;
+
+		for (unsigned i = 0; i < g_cache.size; i++) {
+			if (g_cache.entries[i].offset < 0) {
+				entry = i;
+				break;
+			}
+
+			/* wrap safe comparison of the cache clock */
+			if ((int32_t)(g_cache.entries[i].last_use - g_cache.entries[entry].last_use) < 0) {
+				entry = i;
+			}
+		}
+
+		dm_cache_entry_t *victim = &g_cache.entries[entry];
+
+		/* Write back the evicted sector, the sync is left to the next flush */
+		if (victim->dirty) {
+			if (lseek(g_task_fd, victim->offset, SEEK_SET) != victim->offset ||
+			    write(g_task_fd, cache_data(entry), k_sector_size) != (ssize_t)k_sector_size) {
+				return -1;
+			}
+
+			victim->dirty = false;
+			g_cache.dirty--;
+			g_cache.flushed_sectors++;
+			g_cache.unsynced = true;
+		}
+	}
+
+	unsigned char *data = cache_data(entry);
+	ssize_t len = 0;
+
+	if (fill) {
+		if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
+			g_cache.entries[entry].offset = -1;
+			return -1;
+		}
+
+		len = read(g_task_fd, data, k_sector_size);
+
+		if (len < 0) {
+			g_cache.entries[entry].offset = -1;
+			return -1;
+		}
+	}
+
+	/* A short read is beyond the end of the file written so far, an empty entry */
+	memset(data + len, 0, k_sector_size - len);
+
+	g_cache.entries[entry].offset = offset;
+	g_cache.entries[entry].last_use = ++g_cache.clock;
+	g_cache.entries[entry].dirty = false;
+
+	return entry;
+}
+
+/* Copy the data of a sector to the caller's buffer */
+static ssize_t
+copy_item(const unsigned char *buffer, void *buf, size_t count)
+{
+	/* See if we got data */
+	if (buffer[0] > 0) {
+		/* We got more than requested!!! */
+		if (buffer[0] > count) {
+			return -1;
+		}
+
+		/* Looks good, copy it to the caller's buffer */
+		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+	}
+
+	/* Return the number of bytes of caller data read */
+	return buffer[0];
+}
+
 /* write to the data manager file */
 static ssize_t
 _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
 {
-	unsigned char buffer[k_sector_size];
-	size_t len;
-	int offset;
+	int offset, entry;
 
 	/* Get the offset for this item */
 	offset = calculate_offset(item, index);
@@ -341,6 +741,18 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 		return -1;
 	}
 
+	lock_item_write(item);
+
+	/* The whole sector is replaced, no need to read it */
+	entry = cache_get(offset, false);
+
+	if (entry < 0) {
+		unlock_item_write(item);
+		return -1;
+	}
+
+	unsigned char *buffer = cache_data(entry);
+
 	/* Write out the data, prefixed with length and persistence level */
 	buffer[0] = count;
 	buffer[1] = persistence;
@@ -351,31 +763,20 @@ _write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const v
 		memcpy(buffer + DM_SECTOR_HDR_SIZE, buf, count);
 	}
 
-	count += DM_SECTOR_HDR_SIZE;
-
-	len = -1;
+	/* The sector reaches the file with the next flush */
+	cache_mark_dirty(entry);
 
-	/* Seek to the right spot in the data manager file and write the data item */
-	if (lseek(g_task_fd, offset, SEEK_SET) == offset)
-		if ((len = write(g_task_fd, buffer, count)) == count) {
-			fsync(g_task_fd);        /* Make sure data is written to physical media */
-		}
-
-	/* Make sure the write succeeded */
-	if (len != count) {
-		return -1;
-	}
+	unlock_item_write(item);
 
 	/* All is well... return the number of user data written */
-	return count - DM_SECTOR_HDR_SIZE;
+	return count;
 }
 
 /* Retrieve from the data manager file */
 static ssize_t
 _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 {
-	unsigned char buffer[k_sector_size];
-	int len, offset;
+	int offset, entry;
 
 	/* Get the offset for this item */
 	offset = calculate_offset(item, index);
@@ -391,35 +792,107 @@ _read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	}
 
 	/* Read the prefix and data */
-	len = -1;
+	entry = cache_get(offset, true);
 
-	if (lseek(g_task_fd, offset, SEEK_SET) == offset) {
-		len = read(g_task_fd, buffer, count + DM_SECTOR_HDR_SIZE);
+	/* Check for read error */
+	if (entry < 0) {
+		return -1;
 	}
 
-	/* Check for read error */
-	if (len < 0) {
+	return copy_item(cache_data(entry), buf, count);
+}
+
+/* Check that a range of items is within the item type */
+static bool
+range_valid(dm_item_t item, unsigned char index, unsigned items)
+{
+	return item < DM_KEY_NUM_KEYS && items > 0 && index + items <= g_per_item_max_index[item];
+}
+
+/* Retrieve consecutive items, stops at the first one that is not count bytes */
+static ssize_t
+_read_range(dm_item_t item, unsigned char index, unsigned items, void *buf, size_t count)
+{
+	unsigned i;
+
+	if (!range_valid(item, index, items)) {
 		return -1;
 	}
 
-	/* A zero length entry is a empty entry */
-	if (len == 0) {
-		buffer[0] = 0;
+	for (i = 0; i < items; i++) {
+		if (_read(item, index + i, (unsigned char *)buf + i * count, count) != (ssize_t)count) {
+			break;
+		}
 	}
 
-	/* See if we got data */
-	if (buffer[0] > 0) {
-		/* We got more than requested!!! */
-		if (buffer[0] > count) {
-			return -1;
+	/* Return the number of complete items read */
+	return i;
+}
+
+/* Write consecutive items, they reach the file together with the next flush */
+static ssize_t
+_write_range(dm_item_t item, unsigned char index, unsigned items, dm_persitence_t persistence, const void *buf,
+	     size_t count)
+{
+	unsigned i;
+
+	if (!range_valid(item, index, items)) {
+		return -1;
+	}
+
+	for (i = 0; i < items; i++) {
+		if (_write(item, index + i, persistence, (const unsigned char *)buf + i * count, count) != (ssize_t)count) {
+			break;
 		}
+	}
 
-		/* Looks good, copy it to the caller's buffer */
-		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+	/* Return the number of items written */
+	return i;
+}
+
+/* Set the length of a sector to zero, in the cache if it is cached, otherwise in the file */
+static int
+clear_sector(int offset)
+{
+	int entry = cache_find(offset);
+
+	if (entry >= 0) {
+		unsigned char *buffer = cache_data(entry);
+
+		if (buffer[0]) {
+			buffer[0] = 0;
+			cache_mark_dirty(entry);
+		}
+
+		return 0;
 	}
 
-	/* Return the number of bytes of caller data read */
-	return buffer[0];
+	char buf[1] = { 0 };
+
+	if (lseek(g_task_fd, offset, SEEK_SET) != offset || write(g_task_fd, buf, 1) != 1) {
+		return -1;
+	}
+
+	g_cache.unsynced = true;
+	return 0;
+}
+
+/* Read the sector header from the cache if the sector is cached, otherwise from the file */
+static ssize_t
+read_sector_header(int offset, unsigned char *buffer, size_t count)
+{
+	int entry = cache_find(offset);
+
+	if (entry >= 0) {
+		memcpy(buffer, cache_data(entry), count);
+		return count;
+	}
+
+	if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
+		return -1;
+	}
+
+	return read(g_task_fd, buffer, count);
 }
 
 static int
@@ -435,30 +908,21 @@ _clear(dm_item_t item)
 		return -1;
 	}
 
+	lock_item_write(item);
+
 	/* Clear all items of this type */
 	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++) {
-		char buf[1];
-
-		if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
-			result = -1;
-			break;
-		}
+		unsigned char buf[1];
 
 		/* Avoid SD flash wear by only doing writes where necessary */
-		if (read(g_task_fd, buf, 1) < 1) {
-			break;
+		if (read_sector_header(offset, buf, 1) < 1) {
+			offset += k_sector_size;
+			continue;
 		}
 
 		/* If item has length greater than 0 it needs to be overwritten */
 		if (buf[0]) {
-			if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
-				result = -1;
-				break;
-			}
-
-			buf[0] = 0;
-
-			if (write(g_task_fd, buf, 1) != 1) {
+			if (clear_sector(offset) != 0) {
 				result = -1;
 				break;
 			}
@@ -467,8 +931,13 @@ _clear(dm_item_t item)
 		offset += k_sector_size;
 	}
 
+	unlock_item_write(item);
+
 	/* Make sure data is actually written to physical media */
-	fsync(g_task_fd);
+	if (cache_flush() != 0) {
+		result = -1;
+	}
+
 	return result;
 }
 
@@ -477,25 +946,19 @@ static int
 _restart(dm_reset_reason reason)
 {
 	unsigned char buffer[2];
-	int offset = 0, result = 0;
+	int offset, result = 0;
 
 	/* We need to scan the entire file and invalidate and data that should not persist after the last reset */
 
+	lock_all_items_write();
+
 	/* Loop through all of the data segments and delete those that are not persistent */
-	while (1) {
-		size_t len;
+	for (offset = 0; (unsigned)offset < g_file_size; offset += k_sector_size) {
 
 		/* Get data segment at current offset */
-		if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
-			/* must be at eof */
-			break;
-		}
-
-		len = read(g_task_fd, buffer, sizeof(buffer));
-
-		if (len != sizeof(buffer)) {
-			/* must be at eof */
-			break;
+		if (read_sector_header(offset, buffer, sizeof(buffer)) != sizeof(buffer)) {
+			/* beyond the end of the file written so far */
+			continue;
 		}
 
 		/* check if segment contains data */
@@ -516,31 +979,51 @@ _restart(dm_reset_reason reason)
 
 			/* Set segment to unused if data does not persist */
 			if (clear_entry) {
-				if (lseek(g_task_fd, offset, SEEK_SET) != offset) {
-					result = -1;
-					break;
-				}
-
-				buffer[0] = 0;
-
-				len = write(g_task_fd, buffer, 1);
-
-				if (len != 1) {
+				if (clear_sector(offset) != 0) {
 					result = -1;
 					break;
 				}
 			}
 		}
-
-		offset += k_sector_size;
 	}
 
-	fsync(g_task_fd);
+	unlock_all_items_write();
+
+	if (cache_flush() != 0) {
+		result = -1;
+	}
 
 	/* tell the caller how it went */
 	return result;
 }
 
+/** Reset the data manager file if it was written with a different layout */
+static int
+_check_compat(void)
+{
+	struct dataman_compat_s compat = {};
+
+	if (_read(DM_KEY_COMPAT, 0, &compat, sizeof(compat)) == sizeof(compat) && compat.key == DM_COMPAT_KEY) {
+		return 0;
+	}
+
+	PX4_WARN("Incompatible data manager file %s, resetting it", k_data_manager_device_path);
+
+	for (unsigned i = 0; i < DM_KEY_COMPAT; i++) {
+		if (_clear((dm_item_t)i) != 0) {
+			return -1;
+		}
+	}
+
+	compat.key = DM_COMPAT_KEY;
+
+	if (_write(DM_KEY_COMPAT, 0, DM_PERSIST_POWER_ON_RESET, &compat, sizeof(compat)) != sizeof(compat)) {
+		return -1;
+	}
+
+	return cache_flush();
+}
+
 /** Write to the data manager file */
 __EXPORT ssize_t
 dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
@@ -568,6 +1051,65 @@ dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const
 	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
 }
 
+#ifdef __PX4_POSIX
+/* Retrieve from the mapped data manager file on the caller's thread */
+static ssize_t
+_read_mapped(dm_item_t item, unsigned char index, void *buf, size_t count)
+{
+	ssize_t result = -1;
+
+	/* Get the offset for this item */
+	int offset = calculate_offset(item, index);
+
+	/* If item type or index out of range, or the caller asked for more data than we can handle, return error */
+	if (offset < 0 || count > DM_MAX_DATA_SIZE) {
+		return -1;
+	}
+
+	__sync_fetch_and_add(&g_func_counts[dm_read_func], 1);
+
+	pthread_rwlock_rdlock(&g_item_rwlocks[item]);
+
+	/* The worker unmaps the file under the lock when it exits */
+	if (g_cache.mapped) {
+		result = copy_item(&g_cache.data[offset], buf, count);
+	}
+
+	pthread_rwlock_unlock(&g_item_rwlocks[item]);
+
+	return result;
+}
+
+/* Retrieve consecutive items from the mapped data manager file on the caller's thread */
+static ssize_t
+_read_range_mapped(dm_item_t item, unsigned char index, unsigned items, void *buf, size_t count)
+{
+	ssize_t result = -1;
+
+	if (!range_valid(item, index, items) || count > DM_MAX_DATA_SIZE) {
+		return -1;
+	}
+
+	__sync_fetch_and_add(&g_func_counts[dm_read_range_func], 1);
+
+	pthread_rwlock_rdlock(&g_item_rwlocks[item]);
+
+	if (g_cache.mapped) {
+		const unsigned char *buffer = &g_cache.data[calculate_offset(item, index)];
+
+		for (result = 0; (unsigned)result < items; result++) {
+			if (copy_item(buffer + result * k_sector_size, (unsigned char *)buf + result * count, count) != (ssize_t)count) {
+				break;
+			}
+		}
+	}
+
+	pthread_rwlock_unlock(&g_item_rwlocks[item]);
+
+	return result;
+}
+#endif
+
 /** Retrieve from the data manager file */
 __EXPORT ssize_t
 dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
@@ -579,6 +1121,15 @@ dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
 		return -1;
 	}
 
+#ifdef __PX4_POSIX
+
+	/* No need for a round trip through the worker task if the file is mapped */
+	if (g_cache.mapped) {
+		return _read_mapped(item, index, buf, count);
+	}
+
+#endif
+
 	/* get a work item and queue up a read request */
 	if ((work = create_work_item()) == NULL) {
 		return -1;
@@ -594,6 +1145,71 @@ dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
 	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
 }
 
+/** Retrieve consecutive items of one type from the data manager file */
+__EXPORT ssize_t
+dm_read_range(dm_item_t item, unsigned char index, unsigned items, void *buf, size_t count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit) {
+		return -1;
+	}
+
+#ifdef __PX4_POSIX
+
+	/* No need for a round trip through the worker task if the file is mapped */
+	if (g_cache.mapped) {
+		return _read_range_mapped(item, index, items, buf, count);
+	}
+
+#endif
+
+	/* get a work item and queue up a range read request */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_read_range_func;
+	work->range_params.item = item;
+	work->range_params.index = index;
+	work->range_params.items = items;
+	work->range_params.buf = buf;
+	work->range_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Write consecutive items of one type to the data manager file */
+__EXPORT ssize_t
+dm_write_range(dm_item_t item, unsigned char index, unsigned items, dm_persitence_t persistence, const void *buf,
+	       size_t count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a range write request */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_write_range_func;
+	work->range_params.item = item;
+	work->range_params.index = index;
+	work->range_params.items = items;
+	work->range_params.persistence = persistence;
+	work->range_params.buf = (void *)buf;
+	work->range_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
 __EXPORT int
 dm_clear(dm_item_t item)
 {
@@ -673,6 +1289,55 @@ dm_restart(dm_reset_reason reason)
 	return enqueue_work_item_and_wait_for_result(work);
 }
 
+/* Write all cached changes to the physical media */
+__EXPORT int
+dm_flush(void)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if ((g_fd < 0) || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a flush request */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_flush_func;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return enqueue_work_item_and_wait_for_result(work);
+}
+
+/* Wait for work, but not past the flush deadline if there are unflushed writes */
+static void
+wait_for_work(void)
+{
+	if (g_cache.dirty == 0) {
+		px4_sem_wait(&g_work_queued_sema);
+		return;
+	}
+
+	hrt_abstime now = hrt_absolute_time();
+
+	if (g_cache.flush_deadline <= now) {
+		return;
+	}
+
+	struct timespec ts;
+	px4_clock_gettime(CLOCK_REALTIME, &ts);
+
+	const unsigned billion = (1000 * 1000 * 1000);
+	uint64_t nsecs = ts.tv_nsec + (g_cache.flush_deadline - now) * 1000;
+	ts.tv_sec += nsecs / billion;
+	ts.tv_nsec = nsecs % billion;
+
+	/* a timeout is the regular case, the deadline is checked by the caller */
+	px4_sem_timedwait(&g_work_queued_sema, &ts);
+}
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -686,6 +1351,7 @@ task_main(int argc, char *argv[])
 	}
 
 	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] * k_sector_size);
+	g_file_size = max_offset;
 
 	for (unsigned i = 0; i < dm_number_of_funcs; i++) {
 		g_func_counts[i] = 0;
@@ -700,6 +1366,14 @@ task_main(int argc, char *argv[])
 
 	g_item_locks[DM_KEY_MISSION_STATE] = &g_sys_state_mutex;
 
+#ifdef __PX4_POSIX
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		pthread_rwlock_init(&g_item_rwlocks[i], NULL);
+	}
+
+#endif
+
 	g_task_should_exit = false;
 
 	init_q(&g_work_q);
@@ -747,6 +1421,21 @@ task_main(int argc, char *argv[])
 
 	fsync(g_task_fd);
 
+	if (cache_init() != 0) {
+		close(g_task_fd);
+		warnx("Could not allocate data manager cache");
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	g_read_perf = perf_alloc(PC_ELAPSED, "dm_read");
+	g_write_perf = perf_alloc(PC_ELAPSED, "dm_write");
+	g_flush_perf = perf_alloc(PC_ELAPSED, "dm_flush");
+
+	if (_check_compat() != 0) {
+		PX4_WARN("Could not reset data manager file %s", k_data_manager_device_path);
+	}
+
 	printf("dataman: ");
 	/* see if we need to erase any items based on restart type */
 	int sys_restart_val;
@@ -789,7 +1478,7 @@ task_main(int argc, char *argv[])
 
 		if (!g_task_should_exit) {
 			/* wait for work */
-			px4_sem_wait(&g_work_queued_sema);
+			wait_for_work();
 		}
 
 		/* Empty the work queue */
@@ -799,15 +1488,19 @@ task_main(int argc, char *argv[])
 			switch (work->func) {
 			case dm_write_func:
 				g_func_counts[dm_write_func]++;
+				perf_begin(g_write_perf);
 				work->result =
 					_write(work->write_params.item, work->write_params.index, work->write_params.persistence, work->write_params.buf,
 					       work->write_params.count);
+				perf_end(g_write_perf);
 				break;
 
 			case dm_read_func:
 				g_func_counts[dm_read_func]++;
+				perf_begin(g_read_perf);
 				work->result =
 					_read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
+				perf_end(g_read_perf);
 				break;
 
 			case dm_clear_func:
@@ -820,6 +1513,29 @@ task_main(int argc, char *argv[])
 				work->result = _restart(work->restart_params.reason);
 				break;
 
+			case dm_flush_func:
+				g_func_counts[dm_flush_func]++;
+				work->result = cache_flush();
+				break;
+
+			case dm_read_range_func:
+				g_func_counts[dm_read_range_func]++;
+				perf_begin(g_read_perf);
+				work->result =
+					_read_range(work->range_params.item, work->range_params.index, work->range_params.items,
+						    work->range_params.buf, work->range_params.count);
+				perf_end(g_read_perf);
+				break;
+
+			case dm_write_range_func:
+				g_func_counts[dm_write_range_func]++;
+				perf_begin(g_write_perf);
+				work->result =
+					_write_range(work->range_params.item, work->range_params.index, work->range_params.items,
+						     work->range_params.persistence, work->range_params.buf, work->range_params.count);
+				perf_end(g_write_perf);
+				break;
+
 			default: /* should never happen */
 				work->result = -1;
 				break;
@@ -829,15 +1545,31 @@ task_main(int argc, char *argv[])
 			px4_sem_post(&work->wait_sem);
 		}
 
+		/* Write back the cached changes once they are due */
+		if (g_cache.dirty > 0 && hrt_absolute_time() >= g_cache.flush_deadline) {
+			cache_flush();
+		}
+
 		/* time to go???? */
 		if ((g_task_should_exit) && (g_fd < 0)) {
 			break;
 		}
 	}
 
+	cache_flush();
+
+	/* Wait for readers on the mapping */
+	lock_all_items_write();
+	cache_deinit();
+	unlock_all_items_write();
+
 	close(g_task_fd);
 	g_task_fd = -1;
 
+	perf_free(g_read_perf);
+	perf_free(g_write_perf);
+	perf_free(g_flush_perf);
+
 	/* The work queue is now empty, empty the free queue */
 	for (;;) {
 		if ((work = (work_q_item_t *)sq_remfirst(&(g_free_q.q))) == NULL) {
@@ -854,6 +1586,14 @@ task_main(int argc, char *argv[])
 	px4_sem_destroy(&g_work_queued_sema);
 	px4_sem_destroy(&g_sys_state_mutex);
 
+#ifdef __PX4_POSIX
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		pthread_rwlock_destroy(&g_item_rwlocks[i]);
+	}
+
+#endif
+
 	return 0;
 }
 
@@ -883,9 +1623,18 @@ status(void)
 	/* display usage statistics */
 	warnx("Writes   %d", g_func_counts[dm_write_func]);
 	warnx("Reads    %d", g_func_counts[dm_read_func]);
+	warnx("Range writes %d, reads %d", g_func_counts[dm_write_range_func], g_func_counts[dm_read_range_func]);
 	warnx("Clears   %d", g_func_counts[dm_clear_func]);
 	warnx("Restarts %d", g_func_counts[dm_restart_func]);
+	warnx("Flushes  %d", g_func_counts[dm_flush_func]);
 	warnx("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
+	warnx("Cache %u sectors%s, hits %u, misses %u, dirty %u", g_cache.size, g_cache.mapped ? " (mapped)" : "",
+	      g_cache.hits, g_cache.misses, g_cache.dirty);
+	warnx("Cache flushes %u, sectors written %u, errors %u", g_cache.flushes, g_cache.flushed_sectors,
+	      g_cache.flush_errors);
+	perf_print_counter(g_read_perf);
+	perf_print_counter(g_write_perf);
+	perf_print_counter(g_flush_perf);
 }
 
 static void
@@ -55,6 +55,7 @@ typedef enum {
 	DM_KEY_WAYPOINTS_OFFBOARD_1,	/* (alernate between 0 and 1) */
 	DM_KEY_WAYPOINTS_ONBOARD,	/* Mission way point coordinates generated onboard */
 	DM_KEY_MISSION_STATE,		/* Persistent mission state */
+	DM_KEY_COMPAT,			/* Layout of the data manager file */
 	DM_KEY_NUM_KEYS			/* Total number of item types defined */
 } dm_item_t;
 
@@ -63,15 +64,32 @@ typedef enum {
 /** The maximum number of instances for each item type */
 enum {
 	DM_KEY_SAFE_POINTS_MAX = 8,
-#ifdef __cplusplus
-	DM_KEY_FENCE_POINTS_MAX = fence_s::GEOFENCE_MAX_VERTICES,
-#else
-	DM_KEY_FENCE_POINTS_MAX = GEOFENCE_MAX_VERTICES,
-#endif
+	DM_KEY_FENCE_POINTS_MAX = 64,		/* Vertices of all geofence zones, at most one zone per vertex */
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX = NUM_MISSIONS_SUPPORTED,
-	DM_KEY_MISSION_STATE_MAX = 1
+	DM_KEY_MISSION_STATE_MAX = 1,
+	DM_KEY_COMPAT_MAX = 1
+};
+
+/** Increment when the stored items change in a way the compat key does not capture */
+#define DM_COMPAT_VERSION	1
+
+/**
+ * Identifies the layout of the data manager file. The file is reset when the
+ * stored key differs, as items would be read from the wrong offsets or with
+ * the wrong size otherwise.
+ */
+#define DM_COMPAT_KEY	(((uint64_t)DM_COMPAT_VERSION << 56) | \
+			 ((uint64_t)DM_KEY_SAFE_POINTS_MAX << 48) | \
+			 ((uint64_t)DM_KEY_FENCE_POINTS_MAX << 40) | \
+			 ((uint64_t)NUM_MISSIONS_SUPPORTED << 24) | \
+			 ((uint64_t)sizeof(struct fence_vertex_s) << 16) | \
+			 ((uint64_t)sizeof(struct mission_item_s) << 8) | \
+			 (uint64_t)sizeof(struct mission_s))
+
+struct dataman_compat_s {
+	uint64_t key;
 };
 
 /** Data persistence levels */
@@ -110,6 +128,40 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/**
+ * Retrieve consecutive items of one type from the data manager store
+ *
+ * Item i is copied to buffer + i * buflen. Reading stops at the first item
+ * that is not exactly buflen bytes long.
+ *
+ * @return number of items read, -1 if the range is invalid
+ */
+__EXPORT ssize_t
+dm_read_range(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned char index,		/* The index of the first item */
+	unsigned items,			/* The number of items to retrieve */
+	void *buffer,			/* Pointer to caller data buffer of items * buflen bytes */
+	size_t buflen			/* Length in bytes of each item */
+);
+
+/**
+ * Write consecutive items of one type to the data manager store
+ *
+ * Item i is taken from buffer + i * buflen.
+ *
+ * @return number of items written, -1 if the range is invalid
+ */
+__EXPORT ssize_t
+dm_write_range(
+	dm_item_t item,			/* The item type to store */
+	unsigned char index,		/* The index of the first item */
+	unsigned items,			/* The number of items to store */
+	dm_persitence_t persistence,	/* The persistence level of the items */
+	const void *buffer,		/* Pointer to caller data buffer of items * buflen bytes */
+	size_t buflen			/* Length in bytes of each item */
+);
+
 /** Lock all items of this type */
 __EXPORT void
 dm_lock(
@@ -134,6 +186,16 @@ dm_restart(
 	dm_reset_reason restart_type	/* The last reset type */
 );
 
+/**
+ * Write all cached changes to the physical media.
+ *
+ * Writes are cached and reach the media in batches, at the latest
+ * 200 ms after they were made. Call this when an update has to be
+ * persistent before it is reported as done.
+ */
+__EXPORT int
+dm_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
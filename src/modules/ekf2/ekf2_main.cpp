@@ -59,6 +59,7 @@
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/mavlink_log.h>
+#include <systemlib/perf_counter.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <platforms/px4_defines.h>
@@ -127,6 +128,21 @@ public:
 
 private:
 	static constexpr float _dt_max = 0.02;
+	static constexpr unsigned _lanes_max = 3;		// one lane per IMU instance in sensor_combined
+	static constexpr float _lane_test_ratio_filt = 0.05f;	// low pass coefficient of the lane test ratios
+	static constexpr float _lane_switch_ratio = 2.0f;	// the selected lane has to be this much worse to switch
+	static constexpr hrt_abstime _lane_timeout = 500000;	// a lane without output for this long is not used (us)
+	static constexpr float _lane_blend_tau = 1.0f;		// time constant of the output offsets after a switch (s)
+
+	// one filter instance and its health
+	struct ekf_lane_s {
+		EstimatorInterface *ekf;
+		perf_counter_t perf;		// time spent in the filter update
+		float test_ratio;		// low pass filtered innovation test ratio
+		hrt_abstime time_output;	// time of the last filter output
+		hrt_abstime time_gyro;		// gyro timestamp of the last IMU sample fed to the filter
+	};
+
 	bool		_task_should_exit = false;
 	int		_control_task = -1;			// task handle for task
 	bool 	_replay_mode;	// should we use replay data from a log
@@ -159,9 +175,26 @@ private:
 	math::LowPassFilter2p _lp_pitch_rate;
 	math::LowPassFilter2p _lp_yaw_rate;
 
-	EstimatorInterface *_ekf;
+	ekf_lane_s _lanes[_lanes_max];
+	unsigned _lane_count;		// number of lanes running
+	unsigned _lane_selected;	// lane the outputs are taken from
+	uint8_t _lane_switch_count;
+	int _lanes_requested;		// number of lanes set by EKF2_LANES
+
+	// offsets added to the outputs of the selected lane, they take up the difference
+	// to the previously selected lane and decay to zero after a switch
+	matrix::Quaternion<float> _output_q_offset;
+	Vector3f _output_pos_offset;
+	Vector3f _output_vel_offset;
+	matrix::Quaternion<float> _output_q;	// last attitude output
+	Vector3f _output_pos;			// last position output
+	Vector3f _output_vel;			// last velocity output
+	hrt_abstime _output_time;
+	bool _output_switched;			// lane switched since the last output
 
-	parameters *_params;	// pointer to ekf parameter struct (located in _ekf class instance)
+	EstimatorInterface *_ekf;	// filter of the selected lane
+
+	parameters *_params;	// pointer to ekf parameter struct (located in the class instance of lane 0)
 
 	control::BlockParamFloat *_mag_delay_ms;
 	control::BlockParamFloat *_baro_delay_ms;
@@ -210,6 +243,7 @@ private:
 	control::BlockParamFloat *_requiredHdrift;      // maximum acceptable horizontal drift speed (m/s)
 	control::BlockParamFloat *_requiredVdrift;      // maximum acceptable vertical drift speed (m/s)
 	control::BlockParamInt *_param_record_replay_msg; // indicates if we want to record ekf2 replay messages
+	control::BlockParamInt *_lanes_param;		// number of filter lanes
 
 	// measurement source control
 	control::BlockParamInt
@@ -246,6 +280,31 @@ private:
 
 	int update_subscriptions();
 
+	/**
+	 * Start the filter lanes requested by EKF2_LANES, lane 0 always exists.
+	 */
+	void start_lanes();
+
+	/**
+	 * Largest innovation test ratio of the last fusion of a filter.
+	 *
+	 * The ratio is the squared innovation over its variance scaled by the
+	 * squared gate size, so a value above 1 means the measurement was rejected.
+	 */
+	float lane_test_ratio(EstimatorInterface *ekf);
+
+	/**
+	 * Select the lane used for the outputs.
+	 *
+	 * @param now		current time
+	 */
+	void select_lane(hrt_abstime now);
+
+	/**
+	 * Outputs of the selected lane with the offsets left by a lane switch.
+	 */
+	void get_output(hrt_abstime now, matrix::Quaternion<float> &q, Vector3f &pos, Vector3f &vel);
+
 };
 
 Ekf2::Ekf2():
@@ -263,6 +322,19 @@ Ekf2::Ekf2():
 	_lp_roll_rate(250.0f, 30.0f),
 	_lp_pitch_rate(250.0f, 30.0f),
 	_lp_yaw_rate(250.0f, 20.0f),
+	_lanes{},
+	_lane_count(1),
+	_lane_selected(0),
+	_lane_switch_count(0),
+	_lanes_requested(1),
+	_output_q_offset(1.0f, 0.0f, 0.0f, 0.0f),
+	_output_pos_offset(0.0f, 0.0f, 0.0f),
+	_output_vel_offset(0.0f, 0.0f, 0.0f),
+	_output_q(1.0f, 0.0f, 0.0f, 0.0f),
+	_output_pos(0.0f, 0.0f, 0.0f),
+	_output_vel(0.0f, 0.0f, 0.0f),
+	_output_time(0),
+	_output_switched(false),
 	_ekf(new Ekf()),
 	_params(_ekf->getParamHandle()),
 	_mag_delay_ms(new control::BlockParamFloat(this, "EKF2_MAG_DELAY", false, &_params->mag_delay_ms)),
@@ -305,6 +377,7 @@ Ekf2::Ekf2():
 	_requiredHdrift(new control::BlockParamFloat(this, "EKF2_REQ_HDRIFT", false, &_params->req_hdrift)),
 	_requiredVdrift(new control::BlockParamFloat(this, "EKF2_REQ_VDRIFT", false, &_params->req_vdrift)),
 	_param_record_replay_msg(new control::BlockParamInt(this, "EKF2_REC_RPL", false, &_publish_replay_mode)),
+	_lanes_param(new control::BlockParamInt(this, "EKF2_LANES", false, &_lanes_requested)),
 	_fusion_mode(new control::BlockParamInt(this, "EKF2_AID_MASK", false, &_params->fusion_mode)),
 	_vdist_sensor_type(new control::BlockParamInt(this, "EKF2_HGT_MODE", false, &_params->vdist_sensor_type)),
 	_range_noise(new control::BlockParamFloat(this, "EKF2_RNG_NOISE", false, &_params->range_noise)),
@@ -328,18 +401,165 @@ Ekf2::Ekf2():
 	_flow_pos_y(new control::BlockParamFloat(this, "EKF2_OF_POS_Y", false, &_params->flow_pos_body(1))),
 	_flow_pos_z(new control::BlockParamFloat(this, "EKF2_OF_POS_Z", false, &_params->flow_pos_body(2)))
 {
-
+	_lanes[0].ekf = _ekf;
+	_lanes[0].perf = perf_alloc(PC_ELAPSED, "ekf2_lane0");
 }
 
 Ekf2::~Ekf2()
 {
-
+	for (unsigned i = 0; i < _lane_count; i++) {
+		perf_free(_lanes[i].perf);
+		delete _lanes[i].ekf;
+	}
 }
 
 void Ekf2::print_status()
 {
 	warnx("local position OK %s", (_ekf->local_position_is_valid()) ? "[YES]" : "[NO]");
 	warnx("global position OK %s", (_ekf->global_position_is_valid()) ? "[YES]" : "[NO]");
+
+	for (unsigned i = 0; i < _lane_count; i++) {
+		warnx("lane %u%s test ratio %.2f", i, (i == _lane_selected) ? " [SELECTED]" : "",
+		      (double)_lanes[i].test_ratio);
+		perf_print_counter(_lanes[i].perf);
+	}
+
+	warnx("lane switches %u", (unsigned)_lane_switch_count);
+}
+
+void Ekf2::start_lanes()
+{
+	// perf_alloc keeps the name pointer
+	static const char *const perf_names[_lanes_max] = {"ekf2_lane0", "ekf2_lane1", "ekf2_lane2"};
+
+	unsigned requested = math::constrain(_lanes_requested, 1, (int)_lanes_max);
+
+	for (unsigned i = 1; i < requested; i++) {
+		Ekf *ekf = new Ekf();
+
+		if (ekf == nullptr) {
+			PX4_WARN("lane %u alloc failed", i);
+			break;
+		}
+
+		_lanes[i].ekf = ekf;
+		_lanes[i].perf = perf_alloc(PC_ELAPSED, perf_names[i]);
+		*ekf->getParamHandle() = *_params;
+		_lane_count = i + 1;
+	}
+}
+
+float Ekf2::lane_test_ratio(EstimatorInterface *ekf)
+{
+	float innov[6];
+	float innov_var[6];
+	float gate[6] = {
+		_params->vel_innov_gate, _params->vel_innov_gate, _params->vel_innov_gate,
+		_params->posNE_innov_gate, _params->posNE_innov_gate, _params->baro_innov_gate
+	};
+	float mag_innov[3];
+	float mag_innov_var[3];
+	float ratio = 0.0f;
+
+	ekf->get_vel_pos_innov(innov);
+	ekf->get_vel_pos_innov_var(innov_var);
+	ekf->get_mag_innov(mag_innov);
+	ekf->get_mag_innov_var(mag_innov_var);
+
+	for (unsigned i = 0; i < 6; i++) {
+		if (innov_var[i] > FLT_EPSILON) {
+			ratio = fmaxf(ratio, innov[i] * innov[i] / (gate[i] * gate[i] * innov_var[i]));
+		}
+	}
+
+	for (unsigned i = 0; i < 3; i++) {
+		if (mag_innov_var[i] > FLT_EPSILON) {
+			ratio = fmaxf(ratio, mag_innov[i] * mag_innov[i] /
+				      (_params->mag_innov_gate * _params->mag_innov_gate * mag_innov_var[i]));
+		}
+	}
+
+	return ratio;
+}
+
+void Ekf2::select_lane(hrt_abstime now)
+{
+	unsigned best = _lane_selected;
+
+	for (unsigned i = 0; i < _lane_count; i++) {
+		if (now - _lanes[i].time_output > _lane_timeout) {
+			continue;
+		}
+
+		if (now - _lanes[best].time_output > _lane_timeout || _lanes[i].test_ratio < _lanes[best].test_ratio) {
+			best = i;
+		}
+	}
+
+	if (best == _lane_selected) {
+		return;
+	}
+
+	// leave a lane that stopped producing outputs right away, otherwise
+	// only if it fails its gates and is clearly worse than the best one
+	bool selected_timeout = now - _lanes[_lane_selected].time_output > _lane_timeout;
+	bool selected_failing = _lanes[_lane_selected].test_ratio > 1.0f
+				&& _lanes[_lane_selected].test_ratio > _lane_switch_ratio * _lanes[best].test_ratio;
+
+	if (!selected_timeout && !selected_failing) {
+		return;
+	}
+
+	PX4_WARN("switching from lane %u to %u", _lane_selected, best);
+
+	_lane_selected = best;
+	_lane_switch_count++;
+	_ekf = _lanes[best].ekf;
+	_output_switched = true;
+}
+
+void Ekf2::get_output(hrt_abstime now, matrix::Quaternion<float> &q, Vector3f &pos, Vector3f &vel)
+{
+	float q_lane[4];
+	_ekf->copy_quaternion(q_lane);
+	q = matrix::Quaternion<float>(q_lane[0], q_lane[1], q_lane[2], q_lane[3]);
+	_ekf->get_position(&pos(0));
+	_ekf->get_velocity(&vel(0));
+
+	if (_output_switched && _output_time > 0) {
+		// offsets so that the outputs continue from where the previous lane left them
+		_output_q_offset = _output_q * q.inversed();
+		_output_pos_offset = _output_pos - pos;
+		_output_vel_offset = _output_vel - vel;
+
+	} else if (_output_time > 0) {
+		float decay = 1.0f - math::constrain((now - _output_time) * 1e-6f / _lane_blend_tau, 0.0f, 1.0f);
+
+		// shrink the rotation of the attitude offset, small angles only
+		// remain after a switch, so scaling the vector part is sufficient
+		float sign = (_output_q_offset(0) < 0.0f) ? -1.0f : 1.0f;
+		float v_sq = 0.0f;
+
+		for (unsigned i = 1; i < 4; i++) {
+			_output_q_offset(i) *= sign * decay;
+			v_sq += _output_q_offset(i) * _output_q_offset(i);
+		}
+
+		_output_q_offset(0) = sqrtf(fmaxf(1.0f - v_sq, 0.0f));
+		_output_pos_offset *= decay;
+		_output_vel_offset *= decay;
+	}
+
+	q = _output_q_offset * q;
+	q.normalize();
+	pos += _output_pos_offset;
+	vel += _output_vel_offset;
+
+	_output_q = q;
+	_output_pos = pos;
+	_output_vel = vel;
+	_output_time = now;
+	_output_switched = false;
 }
 
 void Ekf2::task_main()
@@ -363,6 +583,8 @@ void Ekf2::task_main()
 	// initialise parameter cache
 	updateParams();
 
+	start_lanes();
+
 	// initialize data structures outside of loop
 	// because they will else not always be
 	// properly populated
@@ -392,6 +614,11 @@ void Ekf2::task_main()
 			orb_copy(ORB_ID(parameter_update), _params_sub, &update);
 			updateParams();
 
+			// the parameters are bound to lane 0
+			for (unsigned i = 1; i < _lane_count; i++) {
+				*_lanes[i].ekf->getParamHandle() = *_params;
+			}
+
 			// fetch sensor data in next loop
 			continue;
 
@@ -443,19 +670,22 @@ void Ekf2::task_main()
 			now = hrt_absolute_time();
 		}
 
-		// push imu data into estimator
-		_ekf->setIMUData(now, sensors.gyro_integral_dt[0], sensors.accelerometer_integral_dt[0],
-				 &sensors.gyro_integral_rad[0], &sensors.accelerometer_integral_m_s[0]);
+		orb_check(_actuator_armed_sub, &actuator_armed_updated);
+
+		if (actuator_armed_updated) {
+			orb_copy(ORB_ID(actuator_armed), _actuator_armed_sub, &actuator_armed);
+		}
+
+		struct vehicle_land_detected_s vehicle_land_detected = {};
+		orb_check(_vehicle_land_detected_sub, &vehicle_land_detected_updated);
 
-		// read mag data
-		_ekf->setMagData(sensors.magnetometer_timestamp[0], &sensors.magnetometer_ga[0]);
+		if (vehicle_land_detected_updated) {
+			orb_copy(ORB_ID(vehicle_land_detected), _vehicle_land_detected_sub, &vehicle_land_detected);
+		}
 
-		// read baro data
-		_ekf->setBaroData(sensors.baro_timestamp[0], &sensors.baro_alt_meter[0]);
+		struct gps_message gps_msg = {};
 
-		// read gps data if available
 		if (gps_updated) {
-			struct gps_message gps_msg = {};
 			gps_msg.time_usec = gps.timestamp_position;
 			gps_msg.lat = gps.lat;
 			gps_msg.lon = gps.lon;
@@ -473,18 +703,13 @@ void Ekf2::task_main()
 			gps_msg.nsats = gps.satellites_used;
 			//TODO add gdop to gps topic
 			gps_msg.gdop = 0.0f;
-
-			_ekf->setGpsData(gps.timestamp_position, &gps_msg);
 		}
 
-		// read airspeed data if available
 		float eas2tas = airspeed.true_airspeed_m_s / airspeed.indicated_airspeed_m_s;
-		if (airspeed_updated && airspeed.true_airspeed_m_s > 7.0f) {
-			_ekf->setAirspeedData(airspeed.timestamp, &airspeed.true_airspeed_m_s, &eas2tas);
-		}
+
+		flow_message flow;
 
 		if (optical_flow_updated) {
-			flow_message flow;
 			flow.flowdata(0) = optical_flow.pixel_flow_x_integral;
 			flow.flowdata(1) = optical_flow.pixel_flow_y_integral;
 			flow.quality = optical_flow.quality;
@@ -492,62 +717,108 @@ void Ekf2::task_main()
 			flow.gyrodata(1) = optical_flow.gyro_y_rate_integral;
 			flow.gyrodata(2) = optical_flow.gyro_z_rate_integral;
 			flow.dt = optical_flow.integration_timespan;
+		}
+
+		// run the lanes, lane i uses IMU instance i and the mag of the
+		// same instance if there is one, all share the other sensors
+		for (unsigned i = 0; i < _lane_count; i++) {
+			ekf_lane_s &lane = _lanes[i];
 
-			if (!isnan(optical_flow.pixel_flow_y_integral) && !isnan(optical_flow.pixel_flow_x_integral)) {
-				_ekf->setOpticalFlowData(optical_flow.timestamp, &flow);
+			if (i > 0 && (sensors.gyro_integral_dt[i] == 0 || sensors.accelerometer_integral_dt[i] == 0)) {
+				continue;
 			}
-		}
 
-		if (range_finder_updated) {
-			_ekf->setRangeData(range_finder.timestamp, &range_finder.current_distance);
-		}
+			unsigned mag = (sensors.magnetometer_timestamp[i] > 0) ? i : 0;
 
-		orb_check(_actuator_armed_sub, &actuator_armed_updated);
+			perf_begin(lane.perf);
 
-		if (actuator_armed_updated) {
-			orb_copy(ORB_ID(actuator_armed), _actuator_armed_sub, &actuator_armed);
-			_ekf->set_arm_status(actuator_armed.armed);
-		}
+			// push imu data into estimator, sensor_combined is published for every sample of the
+			// primary IMU, the other instances keep their last sample until their gyro timestamp moves on
+			if (i == 0) {
+				lane.ekf->setIMUData(now, sensors.gyro_integral_dt[i], sensors.accelerometer_integral_dt[i],
+						     &sensors.gyro_integral_rad[i * 3], &sensors.accelerometer_integral_m_s[i * 3]);
 
-		orb_check(_vehicle_land_detected_sub, &vehicle_land_detected_updated);
+			} else if (sensors.gyro_timestamp[i] > lane.time_gyro) {
+				lane.ekf->setIMUData(sensors.gyro_timestamp[i], sensors.gyro_integral_dt[i], sensors.accelerometer_integral_dt[i],
+						     &sensors.gyro_integral_rad[i * 3], &sensors.accelerometer_integral_m_s[i * 3]);
+				lane.time_gyro = sensors.gyro_timestamp[i];
+			}
 
-		if (vehicle_land_detected_updated) {
-			struct vehicle_land_detected_s vehicle_land_detected = {};
-			orb_copy(ORB_ID(vehicle_land_detected), _vehicle_land_detected_sub, &vehicle_land_detected);
-			_ekf->set_in_air_status(!vehicle_land_detected.landed);
+			// read mag data
+			lane.ekf->setMagData(sensors.magnetometer_timestamp[mag], &sensors.magnetometer_ga[mag * 3]);
+
+			// read baro data
+			lane.ekf->setBaroData(sensors.baro_timestamp[0], &sensors.baro_alt_meter[0]);
+
+			// read gps data if available
+			if (gps_updated) {
+				lane.ekf->setGpsData(gps.timestamp_position, &gps_msg);
+			}
+
+			// read airspeed data if available
+			if (airspeed_updated && airspeed.true_airspeed_m_s > 7.0f) {
+				lane.ekf->setAirspeedData(airspeed.timestamp, &airspeed.true_airspeed_m_s, &eas2tas);
+			}
+
+			if (optical_flow_updated) {
+				if (!isnan(optical_flow.pixel_flow_y_integral) && !isnan(optical_flow.pixel_flow_x_integral)) {
+					lane.ekf->setOpticalFlowData(optical_flow.timestamp, &flow);
+				}
+			}
+
+			if (range_finder_updated) {
+				lane.ekf->setRangeData(range_finder.timestamp, &range_finder.current_distance);
+			}
+
+			if (actuator_armed_updated) {
+				lane.ekf->set_arm_status(actuator_armed.armed);
+			}
+
+			if (vehicle_land_detected_updated) {
+				lane.ekf->set_in_air_status(!vehicle_land_detected.landed);
+			}
+
+			if (lane.ekf->update()) {
+				lane.time_output = now;
+				lane.test_ratio += _lane_test_ratio_filt * (lane_test_ratio(lane.ekf) - lane.test_ratio);
+			}
+
+			perf_end(lane.perf);
 		}
 
-		// run the EKF update and output
-		if (_ekf->update()) {
+		select_lane(now);
+
+		// outputs of the selected lane
+		if (_lanes[_lane_selected].time_output == now) {
+			const unsigned imu = _lane_selected;
+
+			matrix::Quaternion<float> q;
+			Vector3f output_pos;
+			Vector3f output_vel;
+			get_output(now, q, output_pos, output_vel);
+
 			// generate vehicle attitude quaternion data
 			struct vehicle_attitude_s att = {};
-			_ekf->copy_quaternion(att.q);
-			matrix::Quaternion<float> q(att.q[0], att.q[1], att.q[2], att.q[3]);
 
 			// generate control state data
 			control_state_s ctrl_state = {};
 			ctrl_state.timestamp = hrt_absolute_time();
-			ctrl_state.roll_rate = _lp_roll_rate.apply(sensors.gyro_rad_s[0]);
-			ctrl_state.pitch_rate = _lp_pitch_rate.apply(sensors.gyro_rad_s[1]);
-			ctrl_state.yaw_rate = _lp_yaw_rate.apply(sensors.gyro_rad_s[2]);
+			ctrl_state.roll_rate = _lp_roll_rate.apply(sensors.gyro_rad_s[imu * 3 + 0]);
+			ctrl_state.pitch_rate = _lp_pitch_rate.apply(sensors.gyro_rad_s[imu * 3 + 1]);
+			ctrl_state.yaw_rate = _lp_yaw_rate.apply(sensors.gyro_rad_s[imu * 3 + 2]);
 
 			// Velocity in body frame
-			float velocity[3];
-			_ekf->get_velocity(velocity);
-			Vector3f v_n(velocity);
 			matrix::Dcm<float> R_to_body(q.inversed());
-			Vector3f v_b = R_to_body * v_n;
+			Vector3f v_b = R_to_body * output_vel;
 			ctrl_state.x_vel = v_b(0);
 			ctrl_state.y_vel = v_b(1);
 			ctrl_state.z_vel = v_b(2);
 
 
 			// Local Position NED
-			float position[3];
-			_ekf->get_position(position);
-			ctrl_state.x_pos = position[0];
-			ctrl_state.y_pos = position[1];
-			ctrl_state.z_pos = position[2];
+			ctrl_state.x_pos = output_pos(0);
+			ctrl_state.y_pos = output_pos(1);
+			ctrl_state.z_pos = output_pos(2);
 
 			// Attitude quaternion
 			ctrl_state.q[0] = q(0);
@@ -556,7 +827,7 @@ void Ekf2::task_main()
 			ctrl_state.q[3] = q(3);
 
 			// Acceleration data
-			matrix::Vector<float, 3> acceleration = {&sensors.accelerometer_m_s2[0]};
+			matrix::Vector<float, 3> acceleration = {&sensors.accelerometer_m_s2[imu * 3]};
 
 			float accel_bias = 0.0f;
 			_ekf->get_accel_bias(&accel_bias);
@@ -601,9 +872,9 @@ void Ekf2::task_main()
 			att.q[3] = q(3);
 			att.q_valid = true;
 
-			att.rollspeed = sensors.gyro_rad_s[0];
-			att.pitchspeed = sensors.gyro_rad_s[1];
-			att.yawspeed = sensors.gyro_rad_s[2];
+			att.rollspeed = sensors.gyro_rad_s[imu * 3 + 0];
+			att.pitchspeed = sensors.gyro_rad_s[imu * 3 + 1];
+			att.yawspeed = sensors.gyro_rad_s[imu * 3 + 2];
 
 			// publish vehicle attitude data
 			if (_att_pub == nullptr) {
@@ -615,19 +886,17 @@ void Ekf2::task_main()
 
 			// generate vehicle local position data
 			struct vehicle_local_position_s lpos = {};
-			float pos[3] = {};
-			float vel[3] = {};
+			float pos[3] = {output_pos(0), output_pos(1), output_pos(2)};
+			float vel[3] = {output_vel(0), output_vel(1), output_vel(2)};
 
 			lpos.timestamp = hrt_absolute_time();
 
 			// Position of body origin in local NED frame
-			_ekf->get_position(pos);
 			lpos.x = pos[0];
 			lpos.y = pos[1];
 			lpos.z = pos[2];
 
 			// Velocity of body origin in local NED frame (m/s)
-			_ekf->get_velocity(vel);
 			lpos.vx = vel[0];
 			lpos.vy = vel[1];
 			lpos.vz = vel[2];
@@ -652,7 +921,8 @@ void Ekf2::task_main()
 
 			float terrain_vpos;
 			lpos.dist_bottom_valid = _ekf->get_terrain_vert_pos(&terrain_vpos);
-			lpos.dist_bottom = terrain_vpos - pos[2]; // Distance to bottom surface (ground) in meters
+			// the terrain estimate is relative to the position of the lane itself, without the switch offset
+			lpos.dist_bottom = terrain_vpos - (pos[2] - _output_pos_offset(2)); // Distance to bottom surface (ground) in meters
 			lpos.dist_bottom_rate = -vel[2]; // Distance to bottom surface (ground) change rate
 			lpos.surface_bottom_timestamp	= hrt_absolute_time(); // Time when new bottom surface found
 
@@ -731,6 +1001,13 @@ void Ekf2::task_main()
 		_ekf->get_covariances(status.covariances);
 		_ekf->get_gps_check_status(&status.gps_check_fail_flags);
 		_ekf->get_control_mode(&status.control_mode_flags);
+		status.n_lanes = _lane_count;
+		status.selected_lane = _lane_selected;
+		status.lane_switch_count = _lane_switch_count;
+
+		for (unsigned i = 0; i < _lane_count; i++) {
+			status.lane_test_ratio[i] = _lanes[i].test_ratio;
+		}
 
 		if (_estimator_status_pub == nullptr) {
 			_estimator_status_pub = orb_advertise(ORB_ID(estimator_status), &status);
@@ -465,6 +465,22 @@ PARAM_DEFINE_FLOAT(EKF2_GPS_V_GATE, 5.0f);
  */
 PARAM_DEFINE_INT32(EKF2_REC_RPL, 0);
 
+/**
+ * Number of filter lanes
+ *
+ * Runs one filter per IMU, fed by the gyro and accelerometer of that
+ * instance and the magnetometer of the same instance if present. The
+ * outputs are taken from the lane with the lowest innovation test ratios.
+ * Every additional lane costs the same CPU time as the first one, see
+ * the ekf2_lane perf counters.
+ *
+ * @group EKF2
+ * @min 1
+ * @max 3
+ * @reboot_required true
+ */
+PARAM_DEFINE_INT32(EKF2_LANES, 1);
+
 /**
  * Integer bitmask controlling which external aiding sources will be used.
  *
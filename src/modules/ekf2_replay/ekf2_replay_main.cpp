@@ -37,6 +37,10 @@
  * It uses this data to create sensor data for the ekf2 module. It also subscribes to the
  * output data of the estimator and writes it to a replay log file.
  *
+ * In realtime mode the data is published at the rate it was recorded with the timestamps
+ * moved onto the local clock, so that estimators which run on hrt_absolute_time() rather
+ * than the sensor timestamps can be replayed as well.
+ *
  * @author Roman Bapst
 */
 
@@ -59,6 +63,9 @@
 #include <fstream>
 #include <sstream>
 
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+
 #include <uORB/topics/ekf2_replay.h>
 #include <uORB/topics/sensor_combined.h>
 #include <uORB/topics/vehicle_gps_position.h>
@@ -109,7 +116,9 @@ class Ekf2Replay
 {
 public:
 	// Constructor
-	Ekf2Replay(char *logfile);
+	// @logfile		log file name, relative to the rootfs
+	// @realtime	publish the data at the rate it was recorded
+	Ekf2Replay(char *logfile, bool realtime);
 
 	// Destructor, also kills task
 	~Ekf2Replay();
@@ -142,6 +151,12 @@ private:
 
 	char *_file_name;
 
+	bool _realtime;			// publish at the recorded rate with timestamps on the local clock
+	hrt_abstime _time_offset;	// added to all replayed timestamps in realtime mode
+
+	perf_counter_t _perf_estimator;	// time from publishing the input data to the estimator output
+	perf_counter_t _perf_timeout;	// input data for which no estimator output arrived
+
 	struct log_format_s _formats[100];
 	struct sensor_combined_s _sensors;
 	struct vehicle_gps_position_s _gps;
@@ -170,6 +185,10 @@ private:
 	// @type 	message type
 	void setEstimatorInput(uint8_t *data, uint8_t type);
 
+	// move a timestamp from the log onto the local clock, zero means not set
+	// @t 	timestamp from the log
+	uint64_t localTime(uint64_t t) { return (t != 0) ? t + _time_offset : 0; }
+
 	// publish input data for estimator
 	void publishEstimatorInput();
 
@@ -195,7 +214,7 @@ private:
 	void setUserParams(const char *filename);
 };
 
-Ekf2Replay::Ekf2Replay(char *logfile) :
+Ekf2Replay::Ekf2Replay(char *logfile, bool realtime) :
 	_sensors_pub(nullptr),
 	_gps_pub(nullptr),
 	_landed_pub(nullptr),
@@ -206,6 +225,10 @@ Ekf2Replay::Ekf2Replay(char *logfile) :
 	_innov_sub(-1),
 	_lpos_sub(-1),
 	_control_state_sub(-1),
+	_realtime(realtime),
+	_time_offset(0),
+	_perf_estimator(perf_alloc(PC_ELAPSED, "ekf2_replay_estimator")),
+	_perf_timeout(perf_alloc(PC_COUNT, "ekf2_replay_timeout")),
 	_formats{},
 	_sensors{},
 	_gps{},
@@ -232,7 +255,8 @@ Ekf2Replay::Ekf2Replay(char *logfile) :
 
 Ekf2Replay::~Ekf2Replay()
 {
-
+	perf_free(_perf_estimator);
+	perf_free(_perf_timeout);
 }
 
 void Ekf2Replay::publishEstimatorInput()
@@ -338,11 +362,18 @@ void Ekf2Replay::setEstimatorInput(uint8_t *data, uint8_t type)
 
 		uint8_t *dest_ptr = (uint8_t *)&replay_part1.time_ref;
 		parseMessage(data, dest_ptr, type);
-		_sensors.timestamp = replay_part1.time_ref;
+
+		// the first imu sample defines the offset to the local clock, it is
+		// moved again if there is a gap in the log
+		if (_realtime && (_time_offset == 0 || localTime(replay_part1.time_ref) > hrt_absolute_time() + 1000000)) {
+			_time_offset = hrt_absolute_time() - replay_part1.time_ref;
+		}
+
+		_sensors.timestamp = localTime(replay_part1.time_ref);
 		_sensors.gyro_integral_dt[0] = replay_part1.gyro_integral_dt;
 		_sensors.accelerometer_integral_dt[0] = replay_part1.accelerometer_integral_dt;
-		_sensors.magnetometer_timestamp[0] = replay_part1.magnetometer_timestamp;
-		_sensors.baro_timestamp[0] = replay_part1.baro_timestamp;
+		_sensors.magnetometer_timestamp[0] = localTime(replay_part1.magnetometer_timestamp);
+		_sensors.baro_timestamp[0] = localTime(replay_part1.baro_timestamp);
 		_sensors.gyro_integral_rad[0] = replay_part1.gyro_integral_x_rad;
 		_sensors.gyro_integral_rad[1] = replay_part1.gyro_integral_y_rad;
 		_sensors.gyro_integral_rad[2] = replay_part1.gyro_integral_z_rad;
@@ -353,13 +384,36 @@ void Ekf2Replay::setEstimatorInput(uint8_t *data, uint8_t type)
 		_sensors.magnetometer_ga[1] = replay_part1.magnetometer_y_ga;
 		_sensors.magnetometer_ga[2] = replay_part1.magnetometer_z_ga;
 		_sensors.baro_alt_meter[0] = replay_part1.baro_alt_meter;
+
+		// the other estimators use the rates and the sensor timestamps and priorities,
+		// recover them from the integrals
+		_sensors.gyro_timestamp[0] = _sensors.timestamp;
+		_sensors.accelerometer_timestamp[0] = _sensors.timestamp;
+		_sensors.gyro_priority[0] = ORB_PRIO_DEFAULT;
+		_sensors.accelerometer_priority[0] = ORB_PRIO_DEFAULT;
+		_sensors.magnetometer_priority[0] = ORB_PRIO_DEFAULT;
+
+		if (replay_part1.gyro_integral_dt > 0) {
+			float dt_inv = 1e6f / replay_part1.gyro_integral_dt;
+			_sensors.gyro_rad_s[0] = replay_part1.gyro_integral_x_rad * dt_inv;
+			_sensors.gyro_rad_s[1] = replay_part1.gyro_integral_y_rad * dt_inv;
+			_sensors.gyro_rad_s[2] = replay_part1.gyro_integral_z_rad * dt_inv;
+		}
+
+		if (replay_part1.accelerometer_integral_dt > 0) {
+			float dt_inv = 1e6f / replay_part1.accelerometer_integral_dt;
+			_sensors.accelerometer_m_s2[0] = replay_part1.accelerometer_integral_x_m_s * dt_inv;
+			_sensors.accelerometer_m_s2[1] = replay_part1.accelerometer_integral_y_m_s * dt_inv;
+			_sensors.accelerometer_m_s2[2] = replay_part1.accelerometer_integral_z_m_s * dt_inv;
+		}
+
 		_part1_counter_ref = _message_counter;
 
 	} else if (type == LOG_RPL2_MSG) {
 		uint8_t *dest_ptr = (uint8_t *)&replay_part2.time_pos_usec;
 		parseMessage(data, dest_ptr, type);
-		_gps.timestamp_position = replay_part2.time_pos_usec;
-		_gps.timestamp_velocity = replay_part2.time_vel_usec;
+		_gps.timestamp_position = localTime(replay_part2.time_pos_usec);
+		_gps.timestamp_velocity = localTime(replay_part2.time_vel_usec);
 		_gps.lat = replay_part2.lat;
 		_gps.lon = replay_part2.lon;
 		_gps.fix_type = replay_part2.fix_type;
@@ -378,7 +432,7 @@ void Ekf2Replay::setEstimatorInput(uint8_t *data, uint8_t type)
 	} else if (type == LOG_RPL3_MSG) {
 		uint8_t *dest_ptr = (uint8_t *)&replay_part3.time_flow_usec;
 		parseMessage(data, dest_ptr, type);
-		_flow.timestamp = replay_part3.time_flow_usec;
+		_flow.timestamp = localTime(replay_part3.time_flow_usec);
 		_flow.pixel_flow_x_integral = replay_part3.flow_integral_x;
 		_flow.pixel_flow_y_integral = replay_part3.flow_integral_y;
 		_flow.gyro_x_rate_integral = replay_part3.gyro_integral_x;
@@ -390,7 +444,7 @@ void Ekf2Replay::setEstimatorInput(uint8_t *data, uint8_t type)
 	} else if (type == LOG_RPL4_MSG) {
 		uint8_t *dest_ptr = (uint8_t *)&replay_part4.time_rng_usec;
 		parseMessage(data, dest_ptr, type);
-		_range.timestamp = replay_part4.time_rng_usec;
+		_range.timestamp = localTime(replay_part4.time_rng_usec);
 		_range.current_distance = replay_part4.range_to_ground;
 		_read_part4 = true;
 
@@ -625,20 +679,40 @@ void Ekf2Replay::publishAndWaitForEstimator()
 	// reset the counter reference for the imu replay topic
 	_part1_counter_ref = 0;
 
+	if (_realtime) {
+		// wait until the imu sample is due
+		hrt_abstime now = hrt_absolute_time();
+
+		if (_sensors.timestamp > now) {
+			usleep(_sensors.timestamp - now);
+		}
+	}
+
+	perf_begin(_perf_estimator);
+
 	publishEstimatorInput();
 
-	// wait for estimator output to arrive
-	int pret = px4_poll(&_fds[0], (sizeof(_fds) / sizeof(_fds[0])), 1000);
+	// wait for estimator output to arrive, in realtime mode not longer than a few imu
+	// samples since not every estimator publishes an output for every sample
+	int pret = px4_poll(&_fds[0], (sizeof(_fds) / sizeof(_fds[0])), _realtime ? 20 : 1000);
 
 	if (pret == 0) {
-		PX4_WARN("timeout");
+		perf_cancel(_perf_estimator);
+		perf_count(_perf_timeout);
+
+		if (!_realtime) {
+			PX4_WARN("timeout");
+		}
 	}
 
 	if (pret < 0) {
+		perf_cancel(_perf_estimator);
 		PX4_WARN("poll error");
 	}
 
 	if (_fds[0].revents & POLLIN) {
+		perf_end(_perf_estimator);
+
 		// write all estimator messages to replay log file
 		logIfUpdated();
 	}
@@ -902,6 +976,9 @@ void Ekf2Replay::task_main()
 		}
 	}
 
+	perf_print_counter(_perf_estimator);
+	perf_print_counter(_perf_timeout);
+
 	::close(_write_fd);
 	::close(fd);
 	delete ekf2_replay::instance;
@@ -935,8 +1012,8 @@ int Ekf2Replay::start()
 
 int ekf2_replay_main(int argc, char *argv[])
 {
-	if (argc < 1) {
-		PX4_WARN("usage: ekf2_replay {start|stop|status}");
+	if (argc < 2) {
+		PX4_WARN("usage: ekf2_replay {start <logfile> [-r]|stop|status}");
 		return 1;
 	}
 
@@ -947,7 +1024,14 @@ int ekf2_replay_main(int argc, char *argv[])
 			return 1;
 		}
 
-		ekf2_replay::instance = new Ekf2Replay(argv[2]);
+		if (argc < 3) {
+			PX4_WARN("no logfile given");
+			return 1;
+		}
+
+		bool realtime = (argc > 3 && !strcmp(argv[3], "-r"));
+
+		ekf2_replay::instance = new Ekf2Replay(argv[2], realtime);
 
 		if (ekf2_replay::instance == nullptr) {
 			PX4_WARN("alloc failed");
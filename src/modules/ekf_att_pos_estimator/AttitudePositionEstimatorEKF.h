@@ -202,6 +202,7 @@ private:
     perf_counter_t  _perf_baro;         ///<local performance counter for baro updates
     perf_counter_t  _perf_airspeed;     ///<local performance counter for airspeed updates
     perf_counter_t  _perf_reset;        ///<local performance counter for filter resets
+    perf_counter_t  _perf_fusion;       ///<local performance counter for covariance prediction and measurement fusion
 
     float           _gps_alt_filt;
     float           _baro_alt_filt;
@@ -0,0 +1,253 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+#
+# Generate the covariance prediction of the 22 state EKF (estimator_22states.cpp)
+# from the symbolic process model.
+#
+# usage: covariance_prediction.py estimator_22states.cpp
+#
+# The code between the marker comments in AttPosEKF::CovariancePrediction()
+# is replaced. Requires sympy.
+#
+# States: 0-3 quaternion, 4-6 velocity NED, 7-9 position NED, 10-12 delta angle
+# bias, 13 z delta velocity bias, 14-15 wind NE, 16-18 earth magnetic field,
+# 19-21 body magnetic field.
+#
+# Only states 0-9 have a transition other than identity, so only the first
+# PREDICTED_STATES rows of F*P*F' + G*Q*G' differ from P and only their upper
+# triangle is generated. Process noise on the diagonal is added by hand written
+# code around the generated block.
+#
+
+# for python2.7 compatibility
+from __future__ import print_function
+
+import re
+import sys
+
+import sympy as sp
+from sympy.printing.c import C99CodePrinter
+
+NUM_STATES = 22
+PREDICTED_STATES = 10  # EKF_PREDICTED_STATES in estimator_22states.cpp
+
+BEGIN_MARKER = '    // BEGIN covariance_prediction.py generated code, do not edit'
+END_MARKER = '    // END covariance_prediction.py generated code'
+
+
+def quat_to_tbn(q0, q1, q2, q3):
+    return sp.Matrix([
+        [q0**2 + q1**2 - q2**2 - q3**2, 2*(q1*q2 - q0*q3), 2*(q1*q3 + q0*q2)],
+        [2*(q1*q2 + q0*q3), q0**2 - q1**2 + q2**2 - q3**2, 2*(q2*q3 - q0*q1)],
+        [2*(q1*q3 - q0*q2), 2*(q2*q3 + q0*q1), q0**2 - q1**2 - q2**2 + q3**2]])
+
+
+def process_model():
+    """State transition and noise input matrices over one prediction interval."""
+    q0, q1, q2, q3 = sp.symbols('q0 q1 q2 q3')
+    dax, day, daz = sp.symbols('dax day daz')
+    dvx, dvy, dvz = sp.symbols('dvx dvy dvz')
+    dax_b, day_b, daz_b, dvz_b = sp.symbols('dax_b day_b daz_b dvz_b')
+    dt = sp.Symbol('dt')
+
+    x = sp.Matrix(sp.symbols('x0:%d' % NUM_STATES))
+    subs = {x[0]: q0, x[1]: q1, x[2]: q2, x[3]: q3,
+            x[10]: dax_b, x[11]: day_b, x[12]: daz_b, x[13]: dvz_b}
+
+    # bias corrected delta angle and velocity, the inputs of the strapdown equations
+    da = sp.Matrix([dax - x[10], day - x[11], daz - x[12]])
+    dv = sp.Matrix([dvx, dvy, dvz - x[13]])
+
+    # first order quaternion update with the delta angle
+    q = sp.Matrix(x[0:4])
+    dq = sp.Matrix([
+        [0, -da[0], -da[1], -da[2]],
+        [da[0], 0, da[2], -da[1]],
+        [da[1], -da[2], 0, da[0]],
+        [da[2], da[1], -da[0], 0]]) * q / 2
+    q_new = q + dq
+
+    v_new = sp.Matrix(x[4:7]) + quat_to_tbn(*x[0:4]) * dv
+    p_new = sp.Matrix(x[7:10]) + sp.Matrix(x[4:7]) * dt
+
+    f = sp.Matrix.vstack(q_new, v_new, p_new, sp.Matrix(x[10:NUM_STATES]))
+
+    F = f.jacobian(x).subs(subs)
+
+    # delta angle and delta velocity noise enter through the inputs
+    u = sp.Matrix([dax, day, daz, dvx, dvy, dvz])
+    G = f.jacobian(u).subs(subs)
+    Q = sp.diag(*sp.symbols('daxCov dayCov dazCov dvxCov dvyCov dvzCov'))
+
+    return F, G, Q
+
+
+def generate():
+    F, G, Q = process_model()
+    cov = Q.diagonal()
+
+    # coefficients of F and G, sharing common subexpressions
+    coeffs = []
+
+    for i in range(PREDICTED_STATES):
+        for k in range(NUM_STATES):
+            if not (F[i, k].is_Number or F[i, k].is_Symbol):
+                coeffs.append(F[i, k])
+
+        for m in range(G.cols):
+            if not (G[i, m].is_Number or G[i, m].is_Symbol):
+                coeffs.append(G[i, m])
+
+    # a coefficient and its negation are stored once
+    unique = []
+
+    for c in coeffs:
+        if c not in unique and -c not in unique:
+            unique.append(c)
+
+    temps, reduced = sp.cse(unique, symbols=sp.numbered_symbols('S_'))
+
+    printer = CPrinter({'order': 'none'})
+    lines = ['    float S[%d];' % len(temps), '']
+
+    for sym, e in temps:
+        lines.append('    %s = %s;' % (printer.name(sym), printer.doprint(e)))
+
+    # store the coefficients that are not just a temporary
+    lines.append('')
+    stored = {}
+    num_stored = 0
+
+    for c, e in zip(unique, reduced):
+        if e.is_Symbol or (-e).is_Symbol:
+            stored[c] = e
+
+        else:
+            stored[c] = sp.Symbol('SF_%d' % num_stored)
+            lines.append('    SF[%d] = %s;' % (num_stored, printer.doprint(e)))
+            num_stored += 1
+
+        stored[-c] = -stored[c]
+
+    lines.insert(1, '    float SF[%d];' % num_stored)
+
+    def coeff(e):
+        return stored.get(e, e)
+
+    def p(i, j):
+        return sp.Symbol('P_%d_%d' % (min(i, j), max(i, j)))
+
+    # FP = F*P for the predicted rows, P is read from its upper triangle
+    lines.append('')
+
+    for i in range(PREDICTED_STATES):
+        for k in range(NUM_STATES):
+            e = sp.Add(*[coeff(F[i, l]) * p(l, k) for l in range(NUM_STATES) if F[i, l] != 0], evaluate=False)
+            lines.append('    FP[%d][%d] = %s;' % (i, k, printer.doprint(e)))
+
+    # upper triangle of FP*F' + G*Q*G' within the predicted states,
+    # for the other columns F is the identity and the result is FP itself
+    lines.append('')
+
+    for i in range(PREDICTED_STATES):
+        for j in range(i, PREDICTED_STATES):
+            terms = [sp.Symbol('FP_%d_%d' % (i, l)) * coeff(F[j, l]) for l in range(NUM_STATES) if F[j, l] != 0]
+            terms += [coeff(G[i, m]) * coeff(G[j, m]) * cov[m] for m in range(G.cols)
+                      if G[i, m] != 0 and G[j, m] != 0]
+            lines.append('    nextP[%d][%d] = %s;' % (i, j, printer.doprint(sp.Add(*terms, evaluate=False))))
+
+    return lines
+
+
+class CPrinter(C99CodePrinter):
+    """Single precision, P_i_j, FP_i_j, S_n and SF_n printed as array accesses."""
+
+    def doprint(self, expr):
+        # no parentheses around bare literals
+        return re.sub(r'\((-?[0-9.]+f)\)', r'\1', C99CodePrinter.doprint(self, expr))
+
+    def name(self, sym):
+        parts = sym.name.split('_')
+
+        if parts[0] == 'P':
+            return 'P[%s][%s]' % (parts[1], parts[2])
+
+        if parts[0] == 'FP':
+            return 'FP[%s][%s]' % (parts[1], parts[2])
+
+        if parts[0] in ('S', 'SF'):
+            return '%s[%s]' % (parts[0], parts[1])
+
+        return sym.name
+
+    def _print_Symbol(self, sym):
+        return self.name(sym)
+
+    def _print_Float(self, flt):
+        return '%sf' % C99CodePrinter._print_Float(self, flt)
+
+    def _print_Rational(self, r):
+        return '%sf' % repr(float(r))
+
+    _print_Half = _print_Rational
+
+    def _print_Pow(self, expr):
+        if expr.exp == 2:
+            return 'sq(%s)' % self._print(expr.base)
+
+        return C99CodePrinter._print_Pow(self, expr)
+
+
+def main():
+    if len(sys.argv) != 2:
+        print('usage: %s estimator_22states.cpp' % sys.argv[0], file=sys.stderr)
+        sys.exit(1)
+
+    path = sys.argv[1]
+
+    with open(path) as f:
+        source = f.read().split('\n')
+
+    begin = source.index(BEGIN_MARKER)
+    end = source.index(END_MARKER)
+
+    source[begin + 1:end] = generate()
+
+    with open(path, 'w') as f:
+        f.write('\n'.join(source))
+
+
+if __name__ == '__main__':
+    main()
@@ -184,6 +184,7 @@ AttitudePositionEstimatorEKF::AttitudePositionEstimatorEKF() :
 	_perf_baro(perf_alloc(PC_INTERVAL, "ekf_att_pos_baro_upd")),
 	_perf_airspeed(perf_alloc(PC_INTERVAL, "ekf_att_pos_aspd_upd")),
 	_perf_reset(perf_alloc(PC_COUNT, "ekf_att_pos_reset")),
+	_perf_fusion(perf_alloc(PC_ELAPSED, "ekf_att_pos_fusion")),
 
 	/* states */
 	_gps_alt_filt(0.0f),
@@ -1128,6 +1129,8 @@ void AttitudePositionEstimatorEKF::updateSensorFusion(const bool fuseGPS, const
 		_prediction_last = hrt_absolute_time();
 	}
 
+	perf_begin(_perf_fusion);
+
 	// perform a covariance prediction if the total delta angle has exceeded the limit
 	// or the time limit will be exceeded at the next IMU update
 	if ((_covariancePredictionDt >= (_ekf->covTimeStepMax - _ekf->dtIMU))
@@ -1234,6 +1237,8 @@ void AttitudePositionEstimatorEKF::updateSensorFusion(const bool fuseGPS, const
 			_ekf->fuseRngData = false;
 		}
 	}
+
+	perf_end(_perf_fusion);
 }
 
 int AttitudePositionEstimatorEKF::start()
@@ -1746,7 +1751,7 @@ int AttitudePositionEstimatorEKF::trip_nan()
 		usleep(100000);
 
 		PX4_INFO("tripping stored states[0] with NaN");
-		_ekf->storedStates[0][0] = nan_val;
+		_ekf->storedStates[0].states[0] = nan_val;
 		usleep(100000);
 
 		PX4_INFO("tripping states[9] with NaN");
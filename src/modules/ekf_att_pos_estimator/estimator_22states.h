@@ -110,6 +110,13 @@ public:
     struct mag_state_struct magstate;
     struct mag_state_struct resetMagState;
 
+    // filter state at one time step, kept for the fusion of delayed measurements
+    struct stored_state_struct {
+        uint32_t timeStamp; // system time in msec
+        float states[EKF_STATE_ESTIMATES];
+        float omega[3]; // angular rate used by the optical flow error estimators
+    };
+
 
 
 
@@ -120,8 +127,7 @@ public:
     float Kfusion[EKF_STATE_ESTIMATES]; // Kalman gains
     float states[EKF_STATE_ESTIMATES]; // state matrix
     float resetStates[EKF_STATE_ESTIMATES];
-    float storedStates[EKF_STATE_ESTIMATES][EKF_DATA_BUFFER_SIZE]; // state vectors stored for the last 50 time steps
-    uint32_t statetimeStamp[EKF_DATA_BUFFER_SIZE]; // time stamp for each state vector stored
+    struct stored_state_struct storedStates[EKF_DATA_BUFFER_SIZE]; // ring of the states of the last 50 time steps, in time order
 
     // Times
     uint64_t lastVelPosFusion;  // the time of the last velocity fusion, in the standard time unit of the filter
@@ -229,10 +235,10 @@ public:
 
     bool numericalProtection;
 
-    unsigned storeIndex;
+    unsigned storeIndex; // next slot to write in storedStates
+    unsigned storeCount; // number of valid entries in storedStates
 
     // Optical Flow error estimation
-    float storedOmega[3][EKF_DATA_BUFFER_SIZE]; // angular rate vector stored for the last 50 time steps used by optical flow eror estimators
 
     // Two state EKF used to estimate focal length scale factor and terrain position
     float Popt[2][2];                       // state covariance matrix
@@ -299,6 +305,19 @@ public:
 
     void RecallOmega(float *omegaForFusion, uint64_t msec);
 
+    /**
+     * Find the stored state closest in time.
+     *
+     * The history is written in time order at a nearly constant rate, so the
+     * slot is computed from the time span of the buffer and then corrected
+     * by the few steps of jitter, instead of scanning all entries.
+     *
+     * @param msec the time to look up
+     * @param timeDelta set to the time difference to the returned entry
+     * @return index into storedStates, -1 if nothing is stored
+     */
+    int FindStoredState(uint64_t msec, uint64_t &timeDelta) const;
+
     void quat2Tbn(Mat3f &TBodyNed, const float (&quat)[4]);
 
     void calcEarthRateNED(Vector3f &omega, float latitude);
@@ -6,6 +6,7 @@
 #include <systemlib/perf_counter.h>
 #include <lib/geo/geo.h>
 #include <matrix/Matrix.hpp>
+#include "correction.hpp"
 
 // uORB Subscriptions
 #include <uORB/Subscription.hpp>
@@ -148,6 +149,20 @@ private:
 	// predict the next state
 	void predict();
 
+	// kalman filter correction into dx and P, form selected by LPE_SEQ_UPD,
+	// returns the fault detection statistic
+	template<size_t n_y>
+	float correct(const measurement_row_s (&C)[n_y],
+		      const Vector<float, n_y> &r, const Vector<float, n_y> &R,
+		      Vector<float, n_x> &dx, Matrix<float, n_x, n_x> &P)
+	{
+		if (_seq_update.get()) {
+			return kalmanCorrectSequential<n_x, n_y>(C, r, R, dx, P);
+		}
+
+		return kalmanCorrectMatrix<n_x, n_y>(C, r, R, dx, P);
+	}
+
 	// lidar
 	int  lidarMeasure(Vector<float, n_y_lidar> &y);
 	void lidarCorrect();
@@ -238,6 +253,7 @@ private:
 
 	// general parameters
 	BlockParamInt  _integrate;
+	BlockParamInt  _seq_update;
 
 	// sonar parameters
 	BlockParamFloat  _sonar_z_stddev;
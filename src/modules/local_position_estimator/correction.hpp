@@ -0,0 +1,170 @@
+#pragma once
+
+#include <stdint.h>
+#include <matrix/math.hpp>
+
+// kalman filter correction for the measurement models of the
+// estimator, all of them select or difference at most two states
+// per measurement and have uncorrelated noise
+//
+//	y = C * x + v,	E[vv'] = R = diag(R_1 .. R_n)
+//
+// matrix form
+//
+//	S = C * P * C' + R
+//	K = P * C' * inv(S)
+//	dx = K * r
+//	P(+) = P - K * C * P
+//	beta = r' * inv(S) * r
+//
+// sequential form, for each measurement i with row c_i of C
+//
+//	r_i' = r_i - c_i * dx
+//	s_i = c_i * P * c_i' + R_i
+//	dx += P * c_i' * r_i' / s_i
+//	P -= P * c_i' * c_i * P / s_i
+//	beta += r_i'^2 / s_i
+//
+// for a diagonal R both give the same dx, P and beta, the
+// sequential form needs no inversion and only touches the columns
+// of P selected by the nonzero entries of C
+
+/**
+ * Nonzero entries of one row of a measurement matrix
+ */
+struct measurement_row_s {
+	uint8_t n; // number of entries used
+	uint8_t index[2]; // state index
+	float value[2]; // coefficient
+};
+
+/**
+ * Dense measurement matrix
+ */
+template<size_t n_x, size_t n_y>
+matrix::Matrix<float, n_y, n_x> measurementMatrix(
+	const measurement_row_s (&C)[n_y])
+{
+	matrix::Matrix<float, n_y, n_x> C_dense;
+	C_dense.setZero();
+
+	for (size_t i = 0; i < n_y; i++) {
+		for (uint8_t j = 0; j < C[i].n; j++) {
+			C_dense(i, C[i].index[j]) = C[i].value[j];
+		}
+	}
+
+	return C_dense;
+}
+
+/**
+ * Residual r = y - C * x
+ */
+template<size_t n_x, size_t n_y>
+matrix::Vector<float, n_y> measurementResidual(
+	const measurement_row_s (&C)[n_y],
+	const matrix::Vector<float, n_y> &y,
+	const matrix::Vector<float, n_x> &x)
+{
+	matrix::Vector<float, n_y> r = y;
+
+	for (size_t i = 0; i < n_y; i++) {
+		for (uint8_t j = 0; j < C[i].n; j++) {
+			r(i) -= C[i].value[j] * x(C[i].index[j]);
+		}
+	}
+
+	return r;
+}
+
+/**
+ * Correction with the innovation covariance inverted as a whole
+ *
+ * @param C measurement rows
+ * @param r residual
+ * @param R measurement noise variances
+ * @param dx set to the state correction
+ * @param P state covariance, updated in place
+ * @return fault detection statistic r' * inv(S) * r
+ */
+template<size_t n_x, size_t n_y>
+float kalmanCorrectMatrix(
+	const measurement_row_s (&C)[n_y],
+	const matrix::Vector<float, n_y> &r,
+	const matrix::Vector<float, n_y> &R,
+	matrix::Vector<float, n_x> &dx,
+	matrix::Matrix<float, n_x, n_x> &P)
+{
+	matrix::Matrix<float, n_y, n_x> C_dense = measurementMatrix<n_x, n_y>(C);
+	matrix::Matrix<float, n_y, n_y> S = C_dense * P * C_dense.transpose();
+
+	for (size_t i = 0; i < n_y; i++) {
+		S(i, i) += R(i);
+	}
+
+	matrix::Matrix<float, n_y, n_y> S_I = matrix::inv<float, n_y>(S);
+	matrix::Matrix<float, n_x, n_y> K = P * C_dense.transpose() * S_I;
+	dx = K * r;
+	P -= K * C_dense * P;
+	return (r.transpose() * (S_I * r))(0, 0);
+}
+
+/**
+ * Correction processing one measurement at a time
+ *
+ * @param C measurement rows
+ * @param r residual
+ * @param R measurement noise variances
+ * @param dx set to the state correction
+ * @param P state covariance, updated in place
+ * @return fault detection statistic r' * inv(S) * r
+ */
+template<size_t n_x, size_t n_y>
+float kalmanCorrectSequential(
+	const measurement_row_s (&C)[n_y],
+	const matrix::Vector<float, n_y> &r,
+	const matrix::Vector<float, n_y> &R,
+	matrix::Vector<float, n_x> &dx,
+	matrix::Matrix<float, n_x, n_x> &P)
+{
+	float beta = 0;
+	dx.setZero();
+
+	for (size_t i = 0; i < n_y; i++) {
+		const measurement_row_s &c = C[i];
+
+		// P * c'
+		float PC[n_x];
+
+		for (size_t k = 0; k < n_x; k++) {
+			PC[k] = 0;
+
+			for (uint8_t j = 0; j < c.n; j++) {
+				PC[k] += P(k, c.index[j]) * c.value[j];
+			}
+		}
+
+		// innovation variance and residual given the
+		// corrections of the previous measurements
+		float s = R(i);
+		float r_i = r(i);
+
+		for (uint8_t j = 0; j < c.n; j++) {
+			s += c.value[j] * PC[c.index[j]];
+			r_i -= c.value[j] * dx(c.index[j]);
+		}
+
+		float s_I = 1.0f / s;
+		beta += r_i * r_i * s_I;
+
+		for (size_t k = 0; k < n_x; k++) {
+			dx(k) += PC[k] * r_i * s_I;
+
+			for (size_t l = 0; l < n_x; l++) {
+				P(k, l) -= PC[k] * PC[l] * s_I;
+			}
+		}
+	}
+
+	return beta;
+}
@@ -11,6 +11,18 @@
  */
 PARAM_DEFINE_INT32(LPE_INTEGRATE, 1);
 
+/**
+ * Sequential measurement updates.
+ *
+ * Process the measurements of a sensor one at a time instead
+ * of inverting the innovation covariance. Same result, fewer
+ * operations.
+ *
+ * @boolean
+ * @group Local Position Estimator
+ */
+PARAM_DEFINE_INT32(LPE_SEQ_UPD, 0);
+
 /**
  * Optical flow z offset from center
  *
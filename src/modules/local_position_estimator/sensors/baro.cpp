@@ -57,22 +57,22 @@ void BlockLocalPositionEstimator::baroCorrect()
 	y -= _baroAltHome;
 
 	// baro measurement matrix
-	Matrix<float, n_y_baro, n_x> C;
-	C.setZero();
-	C(Y_baro_z, X_z) = -1; // measured altitude, negative down dir.
+	static const measurement_row_s C[n_y_baro] = {
+		{1, {X_z}, {-1}}, // measured altitude, negative down dir.
+	};
 
-	Matrix<float, n_y_baro, n_y_baro> R;
-	R.setZero();
-	R(0, 0) = _baro_stddev.get() * _baro_stddev.get();
+	Vector<float, n_y_baro> R;
+	R(0) = _baro_stddev.get() * _baro_stddev.get();
 
 	// residual
-	Matrix<float, n_y_baro, n_y_baro> S_I =
-		inv<float, n_y_baro>((C * _P * C.transpose()) + R);
-	Vector<float, n_y_baro> r = y - (C * _x);
+	Vector<float, n_y_baro> r = measurementResidual(C, y, _x);
 
-	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
+	// fault detection
 	if (beta > BETA_TABLE[n_y_baro]) {
 		if (_baroFault < FAULT_MINOR) {
 			//mavlink_and_console_log_info(&mavlink_log_pub, "[lpe] baro fault, r %5.2f m, beta %5.2f",
@@ -87,9 +87,6 @@ void BlockLocalPositionEstimator::baroCorrect()
 
 	// kalman filter correction if no fault
 	if (_baroFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_baro> K = _P * C.transpose() * S_I;
-		Vector<float, n_x> dx = K * r;
-
 		if (!_canEstimateXY) {
 			dx(X_x) = 0;
 			dx(X_y) = 0;
@@ -98,7 +95,7 @@ void BlockLocalPositionEstimator::baroCorrect()
 		}
 
 		_x += dx;
-		_P -= K * C * _P;
+		_P = P;
 	}
 }
 
@@ -126,28 +126,26 @@ void BlockLocalPositionEstimator::flowCorrect()
 	if (flowMeasure(y) != OK) { return; }
 
 	// flow measurement matrix and noise matrix
-	Matrix<float, n_y_flow, n_x> C;
-	C.setZero();
-	C(Y_flow_x, X_x) = 1;
-	C(Y_flow_y, X_y) = 1;
-
-	Matrix<float, n_y_flow, n_y_flow> R;
-	R.setZero();
-	R(Y_flow_x, Y_flow_x) =
+	static const measurement_row_s C[n_y_flow] = {
+		{1, {X_x}, {1}},
+		{1, {X_y}, {1}},
+	};
+
+	Vector<float, n_y_flow> R;
+	R(Y_flow_x) =
 		_flow_xy_stddev.get() * _flow_xy_stddev.get();
-	R(Y_flow_y, Y_flow_y) =
+	R(Y_flow_y) =
 		_flow_xy_stddev.get() * _flow_xy_stddev.get();
 
 	// residual
-	Vector<float, 2> r = y - C * _x;
+	Vector<float, n_y_flow> r = measurementResidual(C, y, _x);
 
-	// residual covariance, (inverse)
-	Matrix<float, n_y_flow, n_y_flow> S_I =
-		inv<float, n_y_flow>(C * _P * C.transpose() + R);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
 	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
-
 	if (beta > BETA_TABLE[n_y_flow]) {
 		if (_flowFault < FAULT_MINOR) {
 			//mavlink_and_console_log_info(&mavlink_log_pub, "[lpe] flow fault,  beta %5.2f", double(beta));
@@ -160,10 +158,8 @@ void BlockLocalPositionEstimator::flowCorrect()
 	}
 
 	if (_flowFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_flow> K =
-			_P * C.transpose() * S_I;
-		_x += K * r;
-		_P -= K * C * _P;
+		_x += dx;
+		_P = P;
 
 	} else {
 		// reset flow integral to current estimate of position
@@ -96,18 +96,17 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	y(5) = y_global(5);
 
 	// gps measurement matrix, measures position and velocity
-	Matrix<float, n_y_gps, n_x> C;
-	C.setZero();
-	C(Y_gps_x, X_x) = 1;
-	C(Y_gps_y, X_y) = 1;
-	C(Y_gps_z, X_z) = 1;
-	C(Y_gps_vx, X_vx) = 1;
-	C(Y_gps_vy, X_vy) = 1;
-	C(Y_gps_vz, X_vz) = 1;
+	static const measurement_row_s C[n_y_gps] = {
+		{1, {X_x}, {1}},
+		{1, {X_y}, {1}},
+		{1, {X_z}, {1}},
+		{1, {X_vx}, {1}},
+		{1, {X_vy}, {1}},
+		{1, {X_vz}, {1}},
+	};
 
 	// gps covariance matrix
-	Matrix<float, n_y_gps, n_y_gps> R;
-	R.setZero();
+	Vector<float, n_y_gps> R;
 
 	// default to parameter, use gps cov if provided
 	float var_xy = _gps_xy_stddev.get() * _gps_xy_stddev.get();
@@ -124,12 +123,12 @@ void BlockLocalPositionEstimator::gpsCorrect()
 		var_z = _sub_gps.get().epv * _sub_gps.get().epv;
 	}
 
-	R(0, 0) = var_xy;
-	R(1, 1) = var_xy;
-	R(2, 2) = var_z;
-	R(3, 3) = var_vxy;
-	R(4, 4) = var_vxy;
-	R(5, 5) = var_vz;
+	R(0) = var_xy;
+	R(1) = var_xy;
+	R(2) = var_z;
+	R(3) = var_vxy;
+	R(4) = var_vxy;
+	R(5) = var_vz;
 
 	// get delayed x and P
 	float t_delay = 0;
@@ -153,12 +152,14 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	Vector<float, n_x> x0 = _xDelay.get(i);
 
 	// residual
-	Vector<float, n_y_gps> r = y - C * x0;
-	Matrix<float, n_y_gps, n_y_gps> S_I = inv<float, 6>(C * _P * C.transpose() + R);
+	Vector<float, n_y_gps> r = measurementResidual(C, y, x0);
 
-	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
+	// fault detection
 	if (beta > BETA_TABLE[n_y_gps]) {
 		if (_gpsFault < FAULT_MINOR) {
 			//mavlink_and_console_log_info(&mavlink_log_pub, "[lpe] gps fault, beta: %5.2f", double(beta));
@@ -178,9 +179,8 @@ void BlockLocalPositionEstimator::gpsCorrect()
 
 	// kalman filter correction if no hard fault
 	if (_gpsFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_gps> K = _P * C.transpose() * S_I;
-		_x += K * r;
-		_P -= K * C * _P;
+		_x += dx;
+		_P = P;
 	}
 }
 
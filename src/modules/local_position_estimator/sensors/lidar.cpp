@@ -65,32 +65,32 @@ void BlockLocalPositionEstimator::lidarCorrect()
 	       cosf(_sub_att.get().pitch);
 
 	// measurement matrix
-	Matrix<float, n_y_lidar, n_x> C;
-	C.setZero();
 	// y = -(z - tz)
 	// TODO could add trig to make this an EKF correction
-	C(Y_lidar_z, X_z) = -1; // measured altitude, negative down dir.
-	C(Y_lidar_z, X_tz) = 1; // measured altitude, negative down dir.
+	static const measurement_row_s C[n_y_lidar] = {
+		{2, {X_z, X_tz}, {-1, 1}}, // measured altitude, negative down dir.
+	};
 
 	// use parameter covariance unless sensor provides reasonable value
-	Matrix<float, n_y_lidar, n_y_lidar> R;
-	R.setZero();
+	Vector<float, n_y_lidar> R;
 	float cov = _sub_lidar->get().covariance;
 
 	if (cov < 1.0e-3f) {
-		R(0, 0) = _lidar_z_stddev.get() * _lidar_z_stddev.get();
+		R(0) = _lidar_z_stddev.get() * _lidar_z_stddev.get();
 
 	} else {
-		R(0, 0) = cov;
+		R(0) = cov;
 	}
 
 	// residual
-	Matrix<float, n_y_lidar, n_y_lidar> S_I = inv<float, n_y_lidar>((C * _P * C.transpose()) + R);
-	Vector<float, n_y_lidar> r = y - C * _x;
+	Vector<float, n_y_lidar> r = measurementResidual(C, y, _x);
 
-	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
+	// fault detection
 	if (beta > BETA_TABLE[n_y_lidar]) {
 		if (_lidarFault < FAULT_MINOR) {
 			_lidarFault = FAULT_MINOR;
@@ -107,9 +107,6 @@ void BlockLocalPositionEstimator::lidarCorrect()
 
 	// kalman filter correction if no fault
 	if (_lidarFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_lidar> K = _P * C.transpose() * S_I;
-		Vector<float, n_x> dx = K * r;
-
 		if (!_canEstimateXY) {
 			dx(X_x) = 0;
 			dx(X_y) = 0;
@@ -118,7 +115,7 @@ void BlockLocalPositionEstimator::lidarCorrect()
 		}
 
 		_x += dx;
-		_P -= K * C * _P;
+		_P = P;
 	}
 }
 
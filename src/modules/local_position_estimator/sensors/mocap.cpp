@@ -62,28 +62,29 @@ void BlockLocalPositionEstimator::mocapCorrect()
 	y -= _mocapHome;
 
 	// mocap measurement matrix, measures position
-	Matrix<float, n_y_mocap, n_x> C;
-	C.setZero();
-	C(Y_mocap_x, X_x) = 1;
-	C(Y_mocap_y, X_y) = 1;
-	C(Y_mocap_z, X_z) = 1;
+	static const measurement_row_s C[n_y_mocap] = {
+		{1, {X_x}, {1}},
+		{1, {X_y}, {1}},
+		{1, {X_z}, {1}},
+	};
 
 	// noise matrix
-	Matrix<float, n_y_mocap, n_y_mocap> R;
-	R.setZero();
+	Vector<float, n_y_mocap> R;
 	float mocap_p_var = _mocap_p_stddev.get()* \
 			    _mocap_p_stddev.get();
-	R(Y_mocap_x, Y_mocap_x) = mocap_p_var;
-	R(Y_mocap_y, Y_mocap_y) = mocap_p_var;
-	R(Y_mocap_z, Y_mocap_z) = mocap_p_var;
+	R(Y_mocap_x) = mocap_p_var;
+	R(Y_mocap_y) = mocap_p_var;
+	R(Y_mocap_z) = mocap_p_var;
 
 	// residual
-	Matrix<float, n_y_mocap, n_y_mocap> S_I = inv<float, n_y_mocap>((C * _P * C.transpose()) + R);
-	Matrix<float, n_y_mocap, 1> r = y - C * _x;
+	Vector<float, n_y_mocap> r = measurementResidual(C, y, _x);
 
-	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
+	// fault detection
 	if (beta > BETA_TABLE[n_y_mocap]) {
 		if (_mocapFault < FAULT_MINOR) {
 			//mavlink_and_console_log_info(&mavlink_log_pub, "[lpe] mocap fault, beta %5.2f", double(beta));
@@ -97,9 +98,8 @@ void BlockLocalPositionEstimator::mocapCorrect()
 
 	// kalman filter correction if no fault
 	if (_mocapFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_mocap> K = _P * C.transpose() * S_I;
-		_x += K * r;
-		_P -= K * C * _P;
+		_x += dx;
+		_P = P;
 	}
 }
 
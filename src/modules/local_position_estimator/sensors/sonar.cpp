@@ -72,28 +72,25 @@ void BlockLocalPositionEstimator::sonarCorrect()
 	}
 
 	// sonar measurement matrix and noise matrix
-	Matrix<float, n_y_sonar, n_x> C;
-	C.setZero();
 	// y = -(z - tz)
 	// TODO could add trig to make this an EKF correction
-	C(Y_sonar_z, X_z) = -1; // measured altitude, negative down dir.
-	C(Y_sonar_z, X_tz) = 1; // measured altitude, negative down dir.
+	static const measurement_row_s C[n_y_sonar] = {
+		{2, {X_z, X_tz}, {-1, 1}}, // measured altitude, negative down dir.
+	};
 
 	// covariance matrix
-	Matrix<float, n_y_sonar, n_y_sonar> R;
-	R.setZero();
-	R(0, 0) = cov;
+	Vector<float, n_y_sonar> R;
+	R(0) = cov;
 
 	// residual
-	Vector<float, n_y_sonar> r = y - C * _x;
+	Vector<float, n_y_sonar> r = measurementResidual(C, y, _x);
 
-	// residual covariance, (inverse)
-	Matrix<float, n_y_sonar, n_y_sonar> S_I =
-		inv<float, n_y_sonar>(C * _P * C.transpose() + R);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
 	// fault detection
-	float beta = (r.transpose()  * (S_I * r))(0, 0);
-
 	if (beta > BETA_TABLE[n_y_sonar]) {
 		if (_sonarFault < FAULT_MINOR) {
 			_sonarFault = FAULT_MINOR;
@@ -110,10 +107,6 @@ void BlockLocalPositionEstimator::sonarCorrect()
 
 	// kalman filter correction if no fault
 	if (_sonarFault < fault_lvl_disable) {
-		Matrix<float, n_x, n_y_sonar> K =
-			_P * C.transpose() * S_I;
-		Vector<float, n_x> dx = K * r;
-
 		if (!_canEstimateXY) {
 			dx(X_x) = 0;
 			dx(X_y) = 0;
@@ -122,7 +115,7 @@ void BlockLocalPositionEstimator::sonarCorrect()
 		}
 
 		_x += dx;
-		_P -= K * C * _P;
+		_P = P;
 	}
 
 }
@@ -62,26 +62,27 @@ void BlockLocalPositionEstimator::visionCorrect()
 	y -= _visionHome;
 
 	// vision measurement matrix, measures position
-	Matrix<float, n_y_vision, n_x> C;
-	C.setZero();
-	C(Y_vision_x, X_x) = 1;
-	C(Y_vision_y, X_y) = 1;
-	C(Y_vision_z, X_z) = 1;
+	static const measurement_row_s C[n_y_vision] = {
+		{1, {X_x}, {1}},
+		{1, {X_y}, {1}},
+		{1, {X_z}, {1}},
+	};
 
 	// noise matrix
-	Matrix<float, n_y_vision, n_y_vision> R;
-	R.setZero();
-	R(Y_vision_x, Y_vision_x) = _vision_xy_stddev.get() * _vision_xy_stddev.get();
-	R(Y_vision_y, Y_vision_y) = _vision_xy_stddev.get() * _vision_xy_stddev.get();
-	R(Y_vision_z, Y_vision_z) = _vision_z_stddev.get() * _vision_z_stddev.get();
+	Vector<float, n_y_vision> R;
+	R(Y_vision_x) = _vision_xy_stddev.get() * _vision_xy_stddev.get();
+	R(Y_vision_y) = _vision_xy_stddev.get() * _vision_xy_stddev.get();
+	R(Y_vision_z) = _vision_z_stddev.get() * _vision_z_stddev.get();
 
 	// residual
-	Matrix<float, n_y_vision, n_y_vision> S_I = inv<float, n_y_vision>((C * _P * C.transpose()) + R);
-	Matrix<float, n_y_vision, 1> r = y - C * _x;
+	Vector<float, n_y_vision> r = measurementResidual(C, y, _x);
 
-	// fault detection
-	float beta = (r.transpose() * (S_I * r))(0, 0);
+	// correction, applied below if there is no fault
+	Vector<float, n_x> dx;
+	Matrix<float, n_x, n_x> P = _P;
+	float beta = correct(C, r, R, dx, P);
 
+	// fault detection
 	if (beta > BETA_TABLE[n_y_vision]) {
 		if (_visionFault < FAULT_MINOR) {
 			//mavlink_and_console_log_info(&mavlink_log_pub, "[lpe] vision position fault, beta %5.2f", double(beta));
@@ -95,9 +96,8 @@ void BlockLocalPositionEstimator::visionCorrect()
 
 	// kalman filter correction if no fault
 	if (_visionFault <  fault_lvl_disable) {
-		Matrix<float, n_x, n_y_vision> K = _P * C.transpose() * S_I;
-		_x += K * r;
-		_P -= K * C * _P;
+		_x += dx;
+		_P = P;
 	}
 }
 
@@ -0,0 +1,206 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_frame_parser.cpp
+ * Frame level MAVLink 1.0 parser working in place on the receive buffer.
+ */
+
+#include <string.h>
+
+#include "mavlink_frame_parser.h"
+
+static const uint8_t mavlink_message_crcs[256] = MAVLINK_MESSAGE_CRCS;
+static const uint8_t mavlink_message_lengths[256] = MAVLINK_MESSAGE_LENGTHS;
+
+MavlinkFrameParser::MavlinkFrameParser(mavlink_status_t *status) :
+	_status(status),
+	_stream_storage{},
+	_stream((uint8_t *)_stream_storage + HEADROOM),
+	_stream_len(0),
+	_data(_stream),
+	_len(0),
+	_pos(0),
+	_datagram(false),
+	_msg{},
+	_zero_copy_count(0),
+	_copy_count(0)
+{
+}
+
+uint8_t *
+MavlinkFrameParser::get_stream_buffer(size_t *space)
+{
+	if (_datagram) {
+		/* switch back to the stream buffer, the datagram is done */
+		_datagram = false;
+		_data = _stream;
+		_len = _stream_len;
+		_pos = 0;
+	}
+
+	*space = STREAM_BUFFER_SIZE - _stream_len;
+	return &_stream[_stream_len];
+}
+
+void
+MavlinkFrameParser::commit(size_t len)
+{
+	if (_stream_len + len > STREAM_BUFFER_SIZE) {
+		len = STREAM_BUFFER_SIZE - _stream_len;
+	}
+
+	_stream_len += len;
+	_len = _stream_len;
+}
+
+void
+MavlinkFrameParser::discard()
+{
+	_stream_len = 0;
+	_data = _stream;
+	_len = 0;
+	_pos = 0;
+	_datagram = false;
+}
+
+void
+MavlinkFrameParser::set_datagram(uint8_t *data, size_t len)
+{
+	_datagram = true;
+	_data = data;
+	_len = len;
+	_pos = 0;
+}
+
+void
+MavlinkFrameParser::compact()
+{
+	if (_pos > 0) {
+		_stream_len -= _pos;
+		memmove(_stream, &_stream[_pos], _stream_len);
+		_len = _stream_len;
+		_pos = 0;
+	}
+}
+
+mavlink_message_t *
+MavlinkFrameParser::next()
+{
+	while (_len - _pos >= MAVLINK_NUM_NON_PAYLOAD_BYTES) {
+		uint8_t *frame = &_data[_pos];
+
+		if (frame[0] != MAVLINK_STX) {
+			/* resync on the next start byte */
+			uint8_t *stx = (uint8_t *)memchr(frame, MAVLINK_STX, _len - _pos);
+			_pos = (stx != nullptr) ? (size_t)(stx - _data) : _len;
+			continue;
+		}
+
+		const uint8_t payload_len = frame[1];
+		const size_t frame_len = payload_len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+		if (_len - _pos < frame_len) {
+			if (_datagram) {
+				/* nothing more will arrive, the start byte may belong to a payload */
+				_pos++;
+				continue;
+			}
+
+			/* wait for the rest of the frame */
+			break;
+		}
+
+		const uint8_t msgid = frame[5];
+
+		uint16_t checksum;
+		crc_init(&checksum);
+		crc_accumulate_buffer(&checksum, (const char *)&frame[1], MAVLINK_CORE_HEADER_LEN + payload_len);
+		crc_accumulate(mavlink_message_crcs[msgid], &checksum);
+
+		if ((uint8_t)(checksum & 0xFF) != frame[MAVLINK_NUM_HEADER_BYTES + payload_len] ||
+		    (uint8_t)(checksum >> 8) != frame[MAVLINK_NUM_HEADER_BYTES + payload_len + 1]) {
+			/* not a frame, the start byte was part of something else */
+			_status->parse_error++;
+			_pos++;
+			continue;
+		}
+
+		_pos += frame_len;
+
+		/* same bookkeeping as mavlink_parse_char() */
+		if (_status->packet_rx_success_count == 0) {
+			_status->packet_rx_drop_count = 0;
+
+		} else {
+			_status->packet_rx_drop_count += (uint8_t)(frame[2] - _status->current_rx_seq - 1);
+		}
+
+		_status->current_rx_seq = frame[2];
+		_status->packet_rx_success_count++;
+
+		/*
+		 * The wire format is identical to mavlink_message_t starting at the magic byte.
+		 * If the payload ends up 8 byte aligned the frame can be handed out in place,
+		 * the checksum field then occupies the two bytes before the start byte, which
+		 * are either headroom or already parsed. The decoders read the full payload
+		 * length of the message id, so a shorter payload has to be copied.
+		 */
+		const uint8_t decode_len = mavlink_message_lengths[msgid];
+
+		if (((uintptr_t)&frame[MAVLINK_NUM_HEADER_BYTES] & 0x7) == 0 && payload_len >= decode_len) {
+			mavlink_message_t *msg = (mavlink_message_t *)(frame - HEADROOM);
+			msg->checksum = checksum;
+			_zero_copy_count++;
+			return msg;
+		}
+
+		/* the frame always fits, from the magic byte on the message has room for the largest one */
+		memcpy(&_msg.magic, frame, frame_len);
+
+		/* the part of the payload that was not sent reads as zero */
+		if (payload_len < decode_len) {
+			memset(&_MAV_PAYLOAD_NON_CONST(&_msg)[payload_len], 0, decode_len - payload_len);
+		}
+
+		_msg.checksum = checksum;
+		_copy_count++;
+		return &_msg;
+	}
+
+	if (!_datagram) {
+		compact();
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_frame_parser.h
+ * Frame level MAVLink 1.0 parser working in place on the receive buffer.
+ *
+ * Instead of running every byte through mavlink_parse_char() the parser
+ * searches for the start byte, reads the length field and validates the
+ * CRC over the whole frame at once. The returned message points into the
+ * receive buffer whenever the frame is suitably aligned, otherwise the frame
+ * is copied with a single memcpy into a scratch message.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mavlink_bridge_header.h"
+
+class MavlinkFrameParser
+{
+public:
+	/**
+	 * Number of bytes a buffer handed to set_datagram() must have in front of the data.
+	 * The data itself has to start at this offset of an 8 byte aligned address so that
+	 * a frame at the start of the buffer can be used as mavlink_message_t in place.
+	 */
+	static constexpr size_t HEADROOM = 2;
+
+#ifdef __PX4_POSIX
+	static constexpr size_t STREAM_BUFFER_SIZE = 2048;
+#else
+	static constexpr size_t STREAM_BUFFER_SIZE = 2 * MAVLINK_MAX_PACKET_LEN;
+#endif
+
+	/**
+	 * @param status	channel status that receives the sequence and error counters
+	 */
+	MavlinkFrameParser(mavlink_status_t *status);
+	~MavlinkFrameParser() = default;
+
+	/**
+	 * Get the free space of the internal stream buffer. Partial frames are
+	 * kept in the buffer until the remaining bytes have been committed.
+	 *
+	 * @param space		set to the number of bytes that may be written
+	 * @return		write pointer
+	 */
+	uint8_t *get_stream_buffer(size_t *space);
+
+	/**
+	 * Make bytes written to the stream buffer available to next().
+	 */
+	void commit(size_t len);
+
+	/**
+	 * Drop all buffered stream data.
+	 */
+	void discard();
+
+	/**
+	 * Parse a self-contained datagram in place. Any trailing partial frame
+	 * is dropped. The caller keeps ownership of the buffer, which must
+	 * provide HEADROOM bytes in front of data.
+	 */
+	void set_datagram(uint8_t *data, size_t len);
+
+	/**
+	 * Get the next valid message.
+	 *
+	 * The returned pointer is only valid until the next call to any
+	 * method of the parser or until the underlying buffer is reused.
+	 *
+	 * @return		message or nullptr if no complete frame is left
+	 */
+	mavlink_message_t *next();
+
+	/**
+	 * Number of messages that were handed out without copying.
+	 */
+	uint32_t zero_copy_count() const { return _zero_copy_count; }
+
+	/**
+	 * Number of messages that had to be copied because of their alignment.
+	 */
+	uint32_t copy_count() const { return _copy_count; }
+
+private:
+	/* Move the unparsed tail of the stream buffer to its start */
+	void compact();
+
+	mavlink_status_t *_status;
+
+	/* 8 byte aligned backing store of the stream buffer, data starts at HEADROOM */
+	uint64_t _stream_storage[(HEADROOM + STREAM_BUFFER_SIZE + 7) / 8];
+	uint8_t *_stream;
+	size_t _stream_len;
+
+	uint8_t *_data;
+	size_t _len;
+	size_t _pos;
+	bool _datagram;
+
+	mavlink_message_t _msg;
+
+	uint32_t _zero_copy_count;
+	uint32_t _copy_count;
+
+	/* do not allow copying this class */
+	MavlinkFrameParser(const MavlinkFrameParser &);
+	MavlinkFrameParser operator=(const MavlinkFrameParser &);
+};
@@ -37,9 +37,13 @@
 #include <crc32.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <errno.h>
+#ifdef __PX4_POSIX
+#include <sys/mman.h>
+#endif
 
 #include "mavlink_ftp.h"
 #include "mavlink_main.h"
@@ -63,7 +67,7 @@ MavlinkFTP::MavlinkFTP(Mavlink* mavlink) :
 
 MavlinkFTP::~MavlinkFTP()
 {
-	
+	_closeSession();
 }
 
 const char*
@@ -215,7 +219,13 @@ MavlinkFTP::_process_request(mavlink_file_transfer_protocol_t* ftp_req, uint8_t
 		errorCode = _workBurst(payload, target_system_id);
 		stream_send = true;
 		break;
-			
+
+	case kCmdBurstAck:
+		// Acks only steer the running stream, they are never answered unless invalid
+		errorCode = _workBurstAck(payload);
+		stream_send = true;
+		break;
+
 	case kCmdWriteFile:
 		errorCode = _workWrite(payload);
 		break;
@@ -464,6 +474,24 @@ MavlinkFTP::_workOpen(PayloadHeader* payload, int oflag)
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
 
+	if (!(oflag & O_WRONLY) && fileSize > 0) {
+#ifdef __PX4_POSIX
+		// Serve read only sessions straight from the page cache
+		void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (mapping != MAP_FAILED) {
+			_session_info.mapping = (uint8_t *)mapping;
+		}
+
+		if (_session_info.mapping == nullptr)
+#endif
+		{
+			// Without a buffer reads fall back to one read() per chunk
+			_session_info.read_buffer = (uint8_t *)malloc(kReadAheadSize);
+			_session_info.read_buffer_len = 0;
+		}
+	}
+
 	payload->session = 0;
 	payload->size = sizeof(uint32_t);
 	*((uint32_t*)payload->data) = fileSize;
@@ -487,13 +515,8 @@ MavlinkFTP::_workRead(PayloadHeader* payload)
 		warnx("request past EOF");
 		return kErrEOF;
 	}
-		
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		warnx("seek fail");
-		return kErrFailErrno;
-	}
 
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+	int bytes_read = _readSession(payload->offset, &payload->data[0], kMaxDataLength);
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
 		warnx("read fail %d", bytes_read);
@@ -522,6 +545,53 @@ MavlinkFTP::_workBurst(PayloadHeader* payload, uint8_t target_system_id)
 	_session_info.stream_chunk_transmitted = 0;
 	_session_info.stream_seq_number = payload->seq_number + 1;
 	_session_info.stream_target_system_id = target_system_id;
+	_session_info.stream_acked_offset = payload->offset;
+	_session_info.stream_eof_sent = false;
+	_session_info.retransmit_count = 0;
+	_session_info.stream_window = 0;
+
+	// A window size in the request selects the windowed mode, plain requests keep the legacy burst
+	if (payload->size == sizeof(uint32_t)) {
+		uint32_t window;
+		memcpy(&window, payload->data, sizeof(window));
+
+		if (window < kMinWindow) {
+			window = kMinWindow;
+
+		} else if (window > kMaxWindow) {
+			window = kMaxWindow;
+		}
+
+		_session_info.stream_window = window;
+	}
+
+	return kErrNone;
+}
+
+/// @brief Responds to a BurstAck command
+MavlinkFTP::ErrorCode
+MavlinkFTP::_workBurstAck(PayloadHeader* payload)
+{
+	if (payload->session != 0 || _session_info.fd < 0 || _session_info.stream_window == 0) {
+		return kErrInvalidSession;
+	}
+
+	// Acks may arrive out of order, only ever move the window forward
+	if (payload->offset > _session_info.stream_acked_offset && payload->offset <= _session_info.stream_offset) {
+		_session_info.stream_acked_offset = payload->offset;
+	}
+
+	// Queue the missing chunks, they are sent ahead of new data
+	unsigned count = payload->size / sizeof(uint32_t);
+
+	for (unsigned i = 0; i < count && _session_info.retransmit_count < kMaxRetransmits; i++) {
+		uint32_t offset;
+		memcpy(&offset, &payload->data[i * sizeof(uint32_t)], sizeof(offset));
+
+		if (offset < _session_info.stream_offset) {
+			_session_info.retransmit[_session_info.retransmit_count++] = offset;
+		}
+	}
 
 	return kErrNone;
 }
@@ -534,6 +604,9 @@ MavlinkFTP::_workWrite(PayloadHeader* payload)
 		return kErrInvalidSession;
 	}
 
+	// Anything read ahead is stale now
+	_session_info.read_buffer_len = 0;
+
 	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
 		// Unable to see to the specified location
 		warnx("seek fail");
@@ -651,10 +724,8 @@ MavlinkFTP::_workTerminate(PayloadHeader* payload)
 		return kErrInvalidSession;
 	}
 	
-	::close(_session_info.fd);
-	_session_info.fd = -1;
-	_session_info.stream_download = false;
-	
+	_closeSession();
+
 	payload->size = 0;
 
 	return kErrNone;
@@ -664,11 +735,7 @@ MavlinkFTP::_workTerminate(PayloadHeader* payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workReset(PayloadHeader* payload)
 {
-	if (_session_info.fd != -1) {
-		::close(_session_info.fd);
-		_session_info.fd = -1;
-		_session_info.stream_download = false;
-	}
+	_closeSession();
 
 	payload->size = 0;
 	
@@ -765,6 +832,87 @@ MavlinkFTP::_workCalcFileCRC32(PayloadHeader* payload)
 	return kErrNone;
 }
 
+/// @brief Closes the open session and releases its read-ahead resources
+void
+MavlinkFTP::_closeSession(void)
+{
+	if (_session_info.fd < 0) {
+		return;
+	}
+
+#ifdef __PX4_POSIX
+	if (_session_info.mapping != nullptr) {
+		munmap(_session_info.mapping, _session_info.file_size);
+		_session_info.mapping = nullptr;
+	}
+#endif
+
+	free(_session_info.read_buffer);
+	_session_info.read_buffer = nullptr;
+	_session_info.read_buffer_len = 0;
+
+	::close(_session_info.fd);
+	_session_info.fd = -1;
+	_session_info.stream_download = false;
+	_session_info.stream_window = 0;
+}
+
+/// @brief Reads up to len bytes at offset from the open session, through the mapping or read-ahead buffer if there is one
+///	@return Returns number of bytes read, 0 at end of file, -1 with errno set on failure
+int
+MavlinkFTP::_readSession(uint32_t offset, uint8_t *dst, unsigned len)
+{
+#ifdef __PX4_POSIX
+	if (_session_info.mapping != nullptr) {
+		if (offset >= _session_info.file_size) {
+			return 0;
+		}
+
+		if (len > _session_info.file_size - offset) {
+			len = _session_info.file_size - offset;
+		}
+
+		memcpy(dst, &_session_info.mapping[offset], len);
+		return len;
+	}
+#endif
+
+	if (_session_info.read_buffer == nullptr) {
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		return ::read(_session_info.fd, dst, len);
+	}
+
+	if (offset < _session_info.read_buffer_offset ||
+	    offset + len > _session_info.read_buffer_offset + _session_info.read_buffer_len) {
+		// Refill from offset, one large read replaces several chunk sized ones
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		int bytes_read = ::read(_session_info.fd, _session_info.read_buffer, kReadAheadSize);
+
+		if (bytes_read < 0) {
+			_session_info.read_buffer_len = 0;
+			return -1;
+		}
+
+		_session_info.read_buffer_offset = offset;
+		_session_info.read_buffer_len = bytes_read;
+	}
+
+	unsigned available = _session_info.read_buffer_offset + _session_info.read_buffer_len - offset;
+
+	if (len > available) {
+		len = available;
+	}
+
+	memcpy(dst, &_session_info.read_buffer[offset - _session_info.read_buffer_offset], len);
+	return len;
+}
+
 /// @brief Guarantees that the payload data is null terminated.
 ///     @return Returns a pointer to the payload data as a char *
 char *
@@ -845,7 +993,12 @@ void MavlinkFTP::send(const hrt_abstime t)
 	if (!_session_info.stream_download) {
 		return;
 	}
-	
+
+	if (_session_info.stream_window > 0) {
+		_sendWindowed();
+		return;
+	}
+
 #ifndef MAVLINK_FTP_UNIT_TEST
 	// Skip send if not enough room
 	unsigned max_bytes_to_send = _mavlink->get_free_tx_buf();
@@ -887,16 +1040,7 @@ void MavlinkFTP::send(const hrt_abstime t)
 		}
 		
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-#ifdef MAVLINK_FTP_DEBUG
-				warnx("stream download: seek fail");
-#endif
-			}
-		}
-		
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _readSession(payload->offset, &payload->data[0], kMaxDataLength);
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
 				error_code = kErrFailErrno;
@@ -946,3 +1090,101 @@ void MavlinkFTP::send(const hrt_abstime t)
 	} while (more_data);
 }
 
+/// @brief Sends windowed burst packets: queued retransmits first, then new data as long as the window allows
+void MavlinkFTP::_sendWindowed(void)
+{
+#ifndef MAVLINK_FTP_UNIT_TEST
+	unsigned max_bytes_to_send;
+
+	if (_mavlink->get_protocol() == UDP || _mavlink->get_protocol() == TCP) {
+		// Network links only report a single packet of space, the window provides the flow control here
+		max_bytes_to_send = kMaxBytesPerCycle;
+
+	} else {
+		max_bytes_to_send = _mavlink->get_free_tx_buf();
+	}
+#endif
+
+	for (;;) {
+#ifndef MAVLINK_FTP_UNIT_TEST
+		if (max_bytes_to_send < get_size()) {
+			break;
+		}
+#endif
+
+		uint32_t offset;
+
+		if (_session_info.retransmit_count > 0) {
+			offset = _session_info.retransmit[--_session_info.retransmit_count];
+
+			if (offset >= _session_info.file_size) {
+				continue;
+			}
+
+		} else if (!_session_info.stream_eof_sent &&
+			   _session_info.stream_offset - _session_info.stream_acked_offset < _session_info.stream_window) {
+			offset = _session_info.stream_offset;
+
+		} else {
+			// Window is full or everything was sent, wait for the next ack
+			break;
+		}
+
+		mavlink_file_transfer_protocol_t ftp_msg;
+		PayloadHeader* payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
+
+		payload->seq_number = _session_info.stream_seq_number++;
+		payload->session = 0;
+		payload->opcode = kRspAck;
+		payload->req_opcode = kCmdBurstReadFile;
+		payload->burst_complete = false;
+		payload->offset = offset;
+
+		ErrorCode error_code = kErrNone;
+		int bytes_read = 0;
+
+		if (offset >= _session_info.file_size) {
+			// The session stays open to serve retransmits until the client terminates it
+			error_code = kErrEOF;
+			_session_info.stream_eof_sent = true;
+
+		} else {
+			bytes_read = _readSession(offset, &payload->data[0], kMaxDataLength);
+
+			if (bytes_read < 0) {
+				error_code = kErrFailErrno;
+				_session_info.stream_download = false;
+			}
+		}
+
+		if (error_code != kErrNone) {
+			payload->opcode = kRspNak;
+			payload->size = 1;
+			uint8_t* pData = &payload->data[0];
+			*pData = error_code; // Straight reference to data[0] is causing bogus gcc array subscript error
+			if (error_code == kErrFailErrno) {
+				int r_errno = errno;
+				payload->size = 2;
+				payload->data[1] = r_errno;
+			}
+
+		} else {
+			payload->size = bytes_read;
+
+			if (offset == _session_info.stream_offset) {
+				_session_info.stream_offset += bytes_read;
+			}
+		}
+
+		ftp_msg.target_system = _session_info.stream_target_system_id;
+		_reply(&ftp_msg);
+
+#ifndef MAVLINK_FTP_UNIT_TEST
+		max_bytes_to_send -= get_size();
+#endif
+
+		if (!_session_info.stream_download) {
+			break;
+		}
+	}
+}
@@ -99,7 +99,8 @@ public:
 		kCmdTruncateFile,	///< Truncate file at <path> to <offset> length
 		kCmdRename,		///< Rename <path1> to <path2>
 		kCmdCalcFileCRC32,	///< Calculate CRC32 for file at <path>
-		kCmdBurstReadFile,	///< Burst download session file
+		kCmdBurstReadFile,	///< Burst download session file, optional <window> in data enables windowed mode
+		kCmdBurstAck,		///< Windowed burst: data received below <offset>, data holds offsets to resend
 		
 		kRspAck = 128,		///< Ack response
 		kRspNak			///< Nak response
@@ -134,6 +135,7 @@ private:
 	ErrorCode	_workOpen(PayloadHeader *payload, int oflag);
 	ErrorCode	_workRead(PayloadHeader *payload);
 	ErrorCode	_workBurst(PayloadHeader* payload, uint8_t target_system_id);
+	ErrorCode	_workBurstAck(PayloadHeader* payload);
 	ErrorCode	_workWrite(PayloadHeader *payload);
 	ErrorCode	_workTerminate(PayloadHeader *payload);
 	ErrorCode	_workReset(PayloadHeader* payload);
@@ -144,6 +146,10 @@ private:
 	ErrorCode	_workRename(PayloadHeader *payload);
 	ErrorCode	_workCalcFileCRC32(PayloadHeader *payload);
 	
+	void		_closeSession(void);
+	int		_readSession(uint32_t offset, uint8_t *dst, unsigned len);
+	void		_sendWindowed(void);
+	
 	uint8_t _getServerSystemId(void);
 	uint8_t _getServerComponentId(void);
 	uint8_t _getServerChannel(void);
@@ -158,6 +164,19 @@ private:
 	/// @brief Maximum data size in RequestHeader::data
 	static const uint8_t	kMaxDataLength = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(PayloadHeader);
 	
+	/// @brief Read-ahead buffer size for read only sessions
+#ifdef __PX4_NUTTX
+	static const unsigned	kReadAheadSize = 1024;
+#else
+	static const unsigned	kReadAheadSize = 4096;
+#endif
+
+	/// @brief Limits for the windowed burst mode
+	static const uint32_t	kMinWindow = kMaxDataLength;
+	static const uint32_t	kMaxWindow = 64 * 1024;
+	static const unsigned	kMaxRetransmits = 16;		///< Offsets queued for selective retransmit
+	static const unsigned	kMaxBytesPerCycle = 16 * 1024;	///< Upper bound of data sent per send() call on network links
+	
 	struct SessionInfo {
 		int		fd;
 		uint32_t	file_size;
@@ -166,6 +185,17 @@ private:
 		uint16_t	stream_seq_number;
 		uint8_t		stream_target_system_id;
 		unsigned	stream_chunk_transmitted;
+		uint32_t	stream_window;		///< Max bytes in flight, 0 for the legacy burst mode
+		uint32_t	stream_acked_offset;	///< Everything below was acknowledged by the client
+		bool		stream_eof_sent;
+		uint32_t	retransmit[kMaxRetransmits];
+		unsigned	retransmit_count;
+		uint8_t		*read_buffer;		///< Read-ahead buffer, nullptr if not allocated
+		uint32_t	read_buffer_offset;	///< File offset of read_buffer[0]
+		unsigned	read_buffer_len;	///< Valid bytes in read_buffer
+#ifdef __PX4_POSIX
+		uint8_t		*mapping;		///< Whole file mapping of read only sessions, nullptr if not mapped
+#endif
 	};
 	struct SessionInfo _session_info;	///< Session info, fd=-1 for no active session
 	
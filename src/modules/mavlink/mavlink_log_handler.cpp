@@ -37,6 +37,9 @@
 #include "mavlink_log_handler.h"
 #include "mavlink_main.h"
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <limits.h>
 #include <time.h>
 
 #define MOUNTPOINT PX4_ROOTFSDIR "/fs/microsd"
@@ -84,6 +87,9 @@ MavlinkLogHandler::new_instance(Mavlink *mavlink)
 MavlinkLogHandler::MavlinkLogHandler(Mavlink *mavlink)
     : MavlinkStream(mavlink)
     , _pLogHandlerHelper(0)
+    , _transfer_start(0)
+    , _transfer_time(0)
+    , _transfer_bytes(0)
 {
 
 }
@@ -149,10 +155,37 @@ MavlinkLogHandler::send(const hrt_abstime /*t*/)
 	//-- An arbitrary count of max log data packets in one go
 	int count = 100;
 	while (_pLogHandlerHelper && _pLogHandlerHelper->current_status == LogListHelper::LOG_HANDLER_SENDING_DATA && _mavlink->get_free_tx_buf() > get_size() && --count) {
-		_log_send_data();
+		//-- Stop if the read-ahead has not caught up yet
+		if (!_log_send_data()) {
+			break;
+		}
 	};
 }
 
+//-------------------------------------------------------------------
+void
+MavlinkLogHandler::print_status()
+{
+	hrt_abstime elapsed = _transfer_time;
+	if (_transfer_start != 0) {
+		elapsed += hrt_elapsed_time(&_transfer_start);
+	}
+	if (_transfer_bytes > 0 && elapsed > 0) {
+		printf("\tlog download:\t%u bytes, %.3f kB/s\n", (unsigned)_transfer_bytes,
+			(double)((float)_transfer_bytes / 1024.0f / ((float)elapsed * 1e-6f)));
+	}
+}
+
+//-------------------------------------------------------------------
+void
+MavlinkLogHandler::_transfer_done()
+{
+	if (_transfer_start != 0) {
+		_transfer_time += hrt_elapsed_time(&_transfer_start);
+		_transfer_start = 0;
+	}
+}
+
 //-------------------------------------------------------------------
 void
 MavlinkLogHandler::_log_request_list(const mavlink_message_t *msg)
@@ -218,6 +251,12 @@ MavlinkLogHandler::_log_request_data(const mavlink_message_t *msg)
         if (_pLogHandlerHelper->current_log_data_remaining > request.count) {
 		_pLogHandlerHelper->current_log_data_remaining = request.count;
         }
+	//-- Start reading ahead
+	_pLogHandlerHelper->start_log_data();
+	//-- Re-requests continue the running transfer
+	if (_transfer_start == 0) {
+		_transfer_start = hrt_absolute_time();
+	}
 	//-- Enable streaming
         _pLogHandlerHelper->current_status = LogListHelper::LOG_HANDLER_SENDING_DATA;
 }
@@ -230,6 +269,7 @@ MavlinkLogHandler::_log_request_erase(const mavlink_message_t* /*msg*/)
 	mavlink_log_erase_t request;
 	mavlink_msg_log_erase_decode(msg, &request);
 	*/
+	_transfer_done();
 	if (_pLogHandlerHelper) {
 		delete _pLogHandlerHelper;
 		_pLogHandlerHelper = 0;
@@ -242,6 +282,7 @@ void
 MavlinkLogHandler::_log_request_end(const mavlink_message_t* /*msg*/)
 {
 	PX4LOG_WARN("MavlinkLogHandler::_log_request_end\n");
+	_transfer_done();
 	if (_pLogHandlerHelper) {
 		delete _pLogHandlerHelper;
 		_pLogHandlerHelper = 0;
@@ -274,7 +315,7 @@ MavlinkLogHandler::_log_send_listing()
 }
 
 //-------------------------------------------------------------------
-void
+bool
 MavlinkLogHandler::_log_send_data()
 {
 	mavlink_log_data_t response;
@@ -282,7 +323,11 @@ MavlinkLogHandler::_log_send_data()
 	if (len > sizeof(response.data)) {
 		len = sizeof(response.data);
 	}
-	size_t read_size = _pLogHandlerHelper->get_log_data(len, response.data);
+	int result = _pLogHandlerHelper->get_log_data(len, response.data);
+	if (result < 0) {
+		return false;
+	}
+	size_t read_size = result;
 	if (read_size < sizeof(response.data)) {
 		memset(&response.data[read_size], 0, sizeof(response.data) - read_size);
 	}
@@ -292,9 +337,12 @@ MavlinkLogHandler::_log_send_data()
 	_mavlink->send_message(MAVLINK_MSG_ID_LOG_DATA, &response);
 	_pLogHandlerHelper->current_log_data_offset    += read_size;
 	_pLogHandlerHelper->current_log_data_remaining -= read_size;
+	_transfer_bytes += read_size;
 	if (read_size < sizeof(response.data) || _pLogHandlerHelper->current_log_data_remaining == 0) {
 		_pLogHandlerHelper->current_status = LogListHelper::LOG_HANDLER_IDLE;
+		_transfer_done();
 	}
+	return true;
 }
 
 //-------------------------------------------------------------------
@@ -307,6 +355,7 @@ LogListHelper::LogListHelper()
 	, current_log_size(0)
 	, current_log_data_offset(0)
 	, current_log_data_remaining(0)
+	, _read_ahead(nullptr)
 {
 	_init();
 }
@@ -314,6 +363,7 @@ LogListHelper::LogListHelper()
 //-------------------------------------------------------------------
 LogListHelper::~LogListHelper()
 {
+	delete _read_ahead;
 	// Remove log data files (if any)
 	unlink(kLogData);
 	unlink(kTmpData);
@@ -352,11 +402,31 @@ LogListHelper::get_entry(int idx, uint32_t& size, uint32_t& date, char* filename
 }
 
 //-------------------------------------------------------------------
-size_t
+void
+LogListHelper::start_log_data()
+{
+	if (!_read_ahead) {
+		_read_ahead = new LogReadAhead;
+		if (_read_ahead && !_read_ahead->start()) {
+			PX4LOG_WARN("MavlinkLogHandler::start_log_data No read-ahead, reading synchronously\n");
+			delete _read_ahead;
+			_read_ahead = nullptr;
+		}
+	}
+	if (_read_ahead) {
+		_read_ahead->request(current_log_filename, current_log_data_offset, current_log_data_remaining);
+	}
+}
+
+//-------------------------------------------------------------------
+int
 LogListHelper::get_log_data(uint8_t len, uint8_t* buffer)
 {
 	if(!current_log_filename[0]) 
 		return 0;
+	if (_read_ahead) {
+		return _read_ahead->read(len, buffer);
+	}
 	FILE* f = fopen(current_log_filename, "r");
 	if (!f) {
 		PX4LOG_WARN("MavlinkLogHandler::get_log_data Could not open %s\n", current_log_filename);
@@ -372,6 +442,208 @@ LogListHelper::get_log_data(uint8_t len, uint8_t* buffer)
 	return result;
 }
 
+//-------------------------------------------------------------------
+LogReadAhead::LogReadAhead()
+	: _thread()
+	, _thread_running(false)
+	, _mutex()
+	, _cond()
+	, _exit(false)
+	, _buffer(nullptr)
+	, _head(0)
+	, _len(0)
+	, _offset(0)
+	, _end(0)
+	, _eof(false)
+	, _generation(0)
+	, _file_generation(0)
+{
+	_filename[0] = 0;
+	pthread_mutex_init(&_mutex, nullptr);
+	pthread_cond_init(&_cond, nullptr);
+}
+
+//-------------------------------------------------------------------
+LogReadAhead::~LogReadAhead()
+{
+	if (_thread_running) {
+		pthread_mutex_lock(&_mutex);
+		_exit = true;
+		pthread_cond_signal(&_cond);
+		pthread_mutex_unlock(&_mutex);
+		pthread_join(_thread, nullptr);
+	}
+	pthread_cond_destroy(&_cond);
+	pthread_mutex_destroy(&_mutex);
+	free(_buffer);
+}
+
+//-------------------------------------------------------------------
+bool
+LogReadAhead::start()
+{
+	_buffer = (uint8_t*)malloc(BUFFER_SIZE);
+	if (!_buffer) {
+		return false;
+	}
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	//-- Below the mavlink thread, file system access must not delay any other stream.
+	//   Without explicit scheduling the thread would inherit the mavlink priority.
+	(void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	(void)pthread_attr_setschedpolicy(&attr, SCHED_DEFAULT);
+	struct sched_param param;
+	(void)pthread_attr_getschedparam(&attr, &param);
+	param.sched_priority = SCHED_PRIORITY_DEFAULT - 40;
+	(void)pthread_attr_setschedparam(&attr, &param);
+	size_t stack_size = 1500;
+#ifdef PTHREAD_STACK_MIN
+	if (stack_size < PTHREAD_STACK_MIN) {
+		stack_size = PTHREAD_STACK_MIN;
+	}
+#endif
+	pthread_attr_setstacksize(&attr, stack_size);
+	_thread_running = pthread_create(&_thread, &attr, LogReadAhead::_thread_helper, this) == 0;
+	pthread_attr_destroy(&attr);
+	return _thread_running;
+}
+
+//-------------------------------------------------------------------
+void
+LogReadAhead::request(const char* filename, uint32_t offset, uint32_t count)
+{
+	pthread_mutex_lock(&_mutex);
+	bool same_file = strcmp(filename, _filename) == 0;
+	if (same_file && offset >= _offset && offset <= _offset + _len) {
+		//-- Keep what was already read for this offset
+		uint32_t skip = offset - _offset;
+		_head    = (_head + skip) % BUFFER_SIZE;
+		_len    -= skip;
+		_offset  = offset;
+		if (_len > count) {
+			_len = count;
+		}
+	} else {
+		if (!same_file) {
+			strncpy(_filename, filename, sizeof(_filename));
+			_filename[sizeof(_filename) - 1] = 0;
+			_file_generation++;
+		}
+		_generation++;
+		_head   = 0;
+		_len    = 0;
+		_offset = offset;
+		_eof    = false;
+	}
+	_end = offset + count;
+	pthread_cond_signal(&_cond);
+	pthread_mutex_unlock(&_mutex);
+}
+
+//-------------------------------------------------------------------
+int
+LogReadAhead::read(uint8_t len, uint8_t* buffer)
+{
+	int result = -1;
+	pthread_mutex_lock(&_mutex);
+	//-- Only hand out short reads at the end, they terminate the transfer
+	if (_len >= len || _eof || _offset + _len >= _end) {
+		unsigned n = _len < len ? _len : len;
+		unsigned first = BUFFER_SIZE - _head;
+		if (first > n) {
+			first = n;
+		}
+		memcpy(buffer, &_buffer[_head], first);
+		memcpy(&buffer[first], _buffer, n - first);
+		_head    = (_head + n) % BUFFER_SIZE;
+		_len    -= n;
+		_offset += n;
+		result   = n;
+		pthread_cond_signal(&_cond);
+	}
+	pthread_mutex_unlock(&_mutex);
+	return result;
+}
+
+//-------------------------------------------------------------------
+void*
+LogReadAhead::_thread_helper(void* context)
+{
+	((LogReadAhead*)context)->_run();
+	return nullptr;
+}
+
+//-------------------------------------------------------------------
+void
+LogReadAhead::_run()
+{
+	int fd = -1;
+	unsigned fd_generation = 0;
+	uint32_t fd_position = 0;
+	pthread_mutex_lock(&_mutex);
+	while (!_exit) {
+		uint32_t fill = _offset + _len;
+		if (!_filename[0] || _eof || _len == BUFFER_SIZE || fill >= _end) {
+			pthread_cond_wait(&_cond, &_mutex);
+			continue;
+		}
+		if (fd_generation != _file_generation) {
+			//-- (Re)open the log, the file system may block for a while
+			char filename[sizeof(_filename)];
+			strcpy(filename, _filename);
+			fd_generation = _file_generation;
+			pthread_mutex_unlock(&_mutex);
+			if (fd >= 0) {
+				::close(fd);
+			}
+			fd = ::open(filename, O_RDONLY);
+			fd_position = 0;
+			pthread_mutex_lock(&_mutex);
+			if (fd < 0) {
+				PX4LOG_WARN("MavlinkLogHandler::read-ahead Could not open %s\n", filename);
+			}
+			continue;
+		}
+		if (fd < 0) {
+			_eof = true;
+			continue;
+		}
+		//-- Fill the contiguous free space behind the valid data
+		unsigned tail = (_head + _len) % BUFFER_SIZE;
+		unsigned n = BUFFER_SIZE - _len;
+		if (n > BUFFER_SIZE - tail) {
+			n = BUFFER_SIZE - tail;
+		}
+		if (n > READ_SIZE) {
+			n = READ_SIZE;
+		}
+		if (n > _end - fill) {
+			n = _end - fill;
+		}
+		unsigned generation = _generation;
+		pthread_mutex_unlock(&_mutex);
+		ssize_t bytes_read = -1;
+		if (fd_position == fill || lseek(fd, fill, SEEK_SET) >= 0) {
+			bytes_read = ::read(fd, &_buffer[tail], n);
+			fd_position = bytes_read > 0 ? fill + bytes_read : (uint32_t)-1;
+		}
+		pthread_mutex_lock(&_mutex);
+		//-- Data for a request which has been replaced meanwhile is dropped
+		if (generation != _generation) {
+			continue;
+		}
+		if (bytes_read <= 0) {
+			_eof = true;
+		} else {
+			_len += bytes_read;
+		}
+	}
+	pthread_mutex_unlock(&_mutex);
+	if (fd >= 0) {
+		::close(fd);
+	}
+}
+
 //-------------------------------------------------------------------
 void
 LogListHelper::_init()
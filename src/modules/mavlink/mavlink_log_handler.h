@@ -37,6 +37,7 @@
 /// @author px4dev, Gus Grubba <mavlink@grubba.com>
 
 #include <dirent.h>
+#include <pthread.h>
 #include <queue.h>
 #include <time.h>
 #include <stdio.h>
@@ -45,6 +46,52 @@
 
 class Mavlink;
 
+// Log Data Read-Ahead
+// A low priority I/O thread keeps a ring buffer filled with the log data
+// following the current offset, so the mavlink thread never waits on the file system.
+class LogReadAhead
+{
+public:
+	LogReadAhead();
+	~LogReadAhead();
+
+	bool	start			();
+	void	request			(const char* filename, uint32_t offset, uint32_t count);
+	int	read			(uint8_t len, uint8_t* buffer);
+
+private:
+	static void* _thread_helper	(void* context);
+	void	_run			();
+
+#ifdef __PX4_NUTTX
+	static const unsigned	BUFFER_SIZE = 4096;
+	static const unsigned	READ_SIZE   = 1024;
+#else
+	static const unsigned	BUFFER_SIZE = 64 * 1024;
+	static const unsigned	READ_SIZE   = 8 * 1024;
+#endif
+
+	pthread_t	_thread;
+	bool		_thread_running;
+	pthread_mutex_t	_mutex;
+	pthread_cond_t	_cond;
+	bool		_exit;
+
+	uint8_t*	_buffer;
+	unsigned	_head;			// Ring index of the byte at _offset
+	unsigned	_len;			// Valid bytes in the ring
+	uint32_t	_offset;		// File offset of the next byte handed out
+	uint32_t	_end;			// File offset where reading stops
+	bool		_eof;			// End of file (or read error) reached
+	unsigned	_generation;		// Bumped when buffered data is thrown away
+	unsigned	_file_generation;	// Bumped when the file changes
+	char		_filename[128];
+
+	/* do not allow copying this class */
+	LogReadAhead(const LogReadAhead&);
+	LogReadAhead operator=(const LogReadAhead&);
+};
+
 // Log Listing Helper
 class LogListHelper
 {
@@ -58,7 +105,8 @@ public:
 public:
 
 	bool 	get_entry		(int idx, uint32_t& size, uint32_t& date, char* filename = 0);
-	size_t 	get_log_data		(uint8_t len, uint8_t* buffer);
+	void	start_log_data		();
+	int 	get_log_data		(uint8_t len, uint8_t* buffer);
 
 	enum {
 		LOG_HANDLER_IDLE,
@@ -78,6 +126,8 @@ public:
 	char		current_log_filename[128];
 
 private:
+	LogReadAhead*	_read_ahead;
+
 	void 	_init			();
 	bool 	_get_session_date	(const char* path, const char* dir, time_t& date);
 	void	_scan_logs		(FILE* f, const char* dir, time_t& date);
@@ -101,6 +151,8 @@ public:
 	unsigned	get_size	(void);
 	void 		send		(const hrt_abstime t);
 
+	void		print_status	();
+
 private:
 	void _log_message	(const mavlink_message_t *msg);
 	void _log_request_list	(const mavlink_message_t *msg);
@@ -108,9 +160,15 @@ private:
 	void _log_request_erase	(const mavlink_message_t *msg);
 	void _log_request_end	(const mavlink_message_t *msg);
 	void _log_send_listing	();
-	void _log_send_data	();
+	bool _log_send_data	();
+	void _transfer_done	();
 
 private:
 	LogListHelper	*_pLogHandlerHelper;
 
+	//-- Throughput of the log data transfers
+	hrt_abstime	_transfer_start;
+	hrt_abstime	_transfer_time;
+	uint32_t	_transfer_bytes;
+
 };
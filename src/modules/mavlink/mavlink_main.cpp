@@ -2303,6 +2303,10 @@ Mavlink::display_status()
 	printf("\ttxerr: %.3f kB/s\n", (double)_rate_txerr);
 	printf("\trx: %.3f kB/s\n", (double)_rate_rx);
 	printf("\trate mult: %.3f\n", (double)_rate_mult);
+
+	if (_mavlink_log_handler != nullptr) {
+		_mavlink_log_handler->print_status();
+	}
 }
 
 int
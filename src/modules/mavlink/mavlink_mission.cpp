@@ -64,6 +64,7 @@ bool MavlinkMissionManager::_dataman_init = false;
 unsigned MavlinkMissionManager::_count = 0;
 int MavlinkMissionManager::_current_seq = 0;
 bool MavlinkMissionManager::_transfer_in_progress = false;
+struct mission_item_s MavlinkMissionManager::_transfer_items[MavlinkMissionManager::TRANSFER_WRITE_BATCH] = {};
 
 #define CHECK_SYSID_COMPID_MISSION(_msg)		(_msg.target_system == mavlink_system.sysid && \
 						((_msg.target_component == mavlink_system.compid) || \
@@ -85,6 +86,7 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) : MavlinkStream(m
 	_transfer_current_seq(0),
 	_transfer_partner_sysid(0),
 	_transfer_partner_compid(0),
+	_transfer_items_count(0),
 	_offboard_mission_sub(-1),
 	_mission_result_sub(-1),
 	_offboard_mission_pub(nullptr),
@@ -152,6 +154,11 @@ MavlinkMissionManager::update_active_mission(int dataman_id, unsigned count, int
 	/* update mission state in dataman */
 	int res = dm_write(DM_KEY_MISSION_STATE, 0, DM_PERSIST_POWER_ON_RESET, &mission, sizeof(mission_s));
 
+	/* the mission items and the state have to be on the media before the mission is acknowledged */
+	if (res == sizeof(mission_s) && dm_flush() != 0) {
+		res = -1;
+	}
+
 	if (res == sizeof(mission_s)) {
 		/* update active mission state */
 		_dataman_id = dataman_id;
@@ -615,6 +622,7 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_count = wpc.count;
 			_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
 			_transfer_current_seq = -1;
+			_transfer_items_count = 0;
 
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
@@ -690,14 +698,23 @@ MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
 
 		dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
 
-		if (dm_write(dm_item, wp.seq, DM_PERSIST_POWER_ON_RESET, &mission_item, sizeof(struct mission_item_s)) != sizeof(struct mission_item_s)) {
-			if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id); }
+		/* collect the items and store them in batches */
+		_transfer_items[_transfer_items_count++] = mission_item;
 
-			send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
-			_mavlink->send_statustext_critical("Unable to write on micro SD");
-			_state = MAVLINK_WPM_STATE_IDLE;
-			_transfer_in_progress = false;
-			return;
+		if (_transfer_items_count == TRANSFER_WRITE_BATCH || wp.seq + 1U == _transfer_count) {
+			const unsigned items = _transfer_items_count;
+			_transfer_items_count = 0;
+
+			if (dm_write_range(dm_item, wp.seq + 1 - items, items, DM_PERSIST_POWER_ON_RESET, _transfer_items,
+					   sizeof(struct mission_item_s)) != (ssize_t)items) {
+				if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id); }
+
+				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
+				_mavlink->send_statustext_critical("Unable to write on micro SD");
+				_state = MAVLINK_WPM_STATE_IDLE;
+				_transfer_in_progress = false;
+				return;
+			}
 		}
 
 		/* waypoint marked as current */
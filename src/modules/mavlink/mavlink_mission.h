@@ -43,6 +43,7 @@
 #pragma once
 
 #include <uORB/uORB.h>
+#include <navigator/navigation.h>
 
 #include "mavlink_bridge_header.h"
 #include "mavlink_rate_limiter.h"
@@ -125,6 +126,10 @@ private:
 	unsigned		_transfer_partner_compid;		///< Partner component ID for current transmission
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
+	static constexpr unsigned	TRANSFER_WRITE_BATCH = 8;	///< Received items written to dataman in one request
+	static struct mission_item_s	_transfer_items[TRANSFER_WRITE_BATCH];	///< Received items not yet written, shared as only one transfer is in progress
+	unsigned		_transfer_items_count;			///< Number of items in _transfer_items
+
 	int			_offboard_mission_sub;
 	int			_mission_result_sub;
 	orb_advert_t		_offboard_mission_pub;
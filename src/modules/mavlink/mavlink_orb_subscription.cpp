@@ -47,12 +47,16 @@
 
 #include "mavlink_orb_subscription.h"
 
+MavlinkOrbSubscription::Snapshot *MavlinkOrbSubscription::_snapshots = nullptr;
+pthread_mutex_t MavlinkOrbSubscription::_snapshots_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 MavlinkOrbSubscription::MavlinkOrbSubscription(const orb_id_t topic, int instance) :
 	next(nullptr),
 	_topic(topic),
 	_instance(instance),
 	_fd(orb_subscribe_multi(_topic, instance)),
-	_published(false)
+	_published(false),
+	_snapshot(get_snapshot(topic, instance))
 {
 }
 
@@ -73,18 +77,118 @@ MavlinkOrbSubscription::get_instance() const
 	return _instance;
 }
 
+MavlinkOrbSubscription::Snapshot *
+MavlinkOrbSubscription::get_snapshot(const orb_id_t topic, int instance)
+{
+	Snapshot *snapshot;
+
+	pthread_mutex_lock(&_snapshots_mutex);
+
+	LL_FOREACH(_snapshots, snapshot) {
+		if (snapshot->topic == topic && snapshot->instance == instance) {
+			break;
+		}
+	}
+
+	if (snapshot == nullptr) {
+		/* snapshots live as long as the process, other instances may still use them */
+		snapshot = (Snapshot *)malloc(sizeof(Snapshot) + topic->o_size);
+
+		if (snapshot != nullptr) {
+			snapshot->next = nullptr;
+			snapshot->topic = topic;
+			snapshot->instance = instance;
+			snapshot->time = 0;
+			snapshot->valid = false;
+			LL_APPEND(_snapshots, snapshot);
+		}
+	}
+
+	pthread_mutex_unlock(&_snapshots_mutex);
+
+	return snapshot;
+}
+
 bool
-MavlinkOrbSubscription::update(uint64_t *time, void* data)
+MavlinkOrbSubscription::copy_snapshot(uint64_t time_topic, void *data)
 {
-	// TODO this is NOT atomic operation, we can get data newer than time
-	// if topic was published between orb_stat and orb_copy calls.
+	if (!_snapshot->valid || _snapshot->time != time_topic) {
+		/*
+		 * Another instance did not copy this publication yet. Check the publication
+		 * time again after the copy, a publication in between would leave us with
+		 * data newer than the time stored with it.
+		 */
+		_snapshot->valid = false;
+
+		for (int i = 0; i < 3; i++) {
+			/* the copy is at least as new as the publication seen before it */
+			_snapshot->time = time_topic;
+
+			if (orb_copy(_topic, _fd, _snapshot->data)) {
+				return false;
+			}
+
+			uint64_t time_copied;
+
+			if (orb_stat(_fd, &time_copied)) {
+				time_copied = 0;
+			}
+
+			if (time_copied == time_topic) {
+				_snapshot->valid = true;
+				break;
+			}
+
+			time_topic = time_copied;
+		}
+
+		/*
+		 * If every copy raced a publication the data is still handed out with the
+		 * time seen before the last copy. The snapshot stays invalid so that the
+		 * next update copies again.
+		 */
+	}
+
+	if (data) {
+		memcpy(data, _snapshot->data, _topic->o_size);
+	}
+
+	return true;
+}
 
+bool
+MavlinkOrbSubscription::update(uint64_t *time, void* data)
+{
 	uint64_t time_topic;
 	if (orb_stat(_fd, &time_topic)) {
 		/* error getting last topic publication time */
 		time_topic = 0;
 	}
 
+	if (_snapshot != nullptr) {
+		pthread_mutex_lock(&_snapshots_mutex);
+		bool copied = copy_snapshot(time_topic, data);
+		time_topic = _snapshot->time;
+		pthread_mutex_unlock(&_snapshots_mutex);
+
+		if (!copied) {
+			if (data) {
+				/* error copying topic data */
+				memset(data, 0, _topic->o_size);
+			}
+			return false;
+		}
+
+		_published = true;
+		if (time_topic != *time) {
+			*time = time_topic;
+			return true;
+
+		} else {
+			return false;
+		}
+	}
+
 	if (orb_copy(_topic, _fd, data)) {
 		if (data) {
 			/* error copying topic data */
@@ -108,6 +212,19 @@ MavlinkOrbSubscription::update(uint64_t *time, void* data)
 bool
 MavlinkOrbSubscription::update(void* data)
 {
+	if (_snapshot != nullptr) {
+		uint64_t time_topic;
+		if (orb_stat(_fd, &time_topic)) {
+			time_topic = 0;
+		}
+
+		pthread_mutex_lock(&_snapshots_mutex);
+		bool copied = copy_snapshot(time_topic, data);
+		pthread_mutex_unlock(&_snapshots_mutex);
+
+		return copied;
+	}
+
 	return !orb_copy(_topic, _fd, data);
 }
 
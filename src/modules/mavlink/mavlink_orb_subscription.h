@@ -35,12 +35,17 @@
  * @file mavlink_orb_subscription.h
  * uORB subscription definition.
  *
+ * The last copied data of every topic instance is kept in a snapshot shared
+ * by all mavlink instances, so a topic update is copied out of uORB only
+ * once no matter how many links send it.
+ *
  * @author Anton Babushkin <anton.babushkin@me.com>
  */
 
 #ifndef MAVLINK_ORB_SUBSCRIPTION_H_
 #define MAVLINK_ORB_SUBSCRIPTION_H_
 
+#include <pthread.h>
 #include <systemlib/uthash/utlist.h>
 #include <drivers/drv_hrt.h>
 
@@ -80,10 +85,36 @@ public:
 	int get_instance() const;
 
 private:
+	/**
+	 * Process wide copy of the latest data of one topic instance.
+	 */
+	struct Snapshot {
+		Snapshot *next;
+		orb_id_t topic;
+		int instance;
+		uint64_t time;		///< publication time of data
+		bool valid;		///< data has been copied at least once
+		uint8_t data[];
+	};
+
+	/**
+	 * Bring the shared snapshot up to date with the publication time
+	 * and copy it to data. Must be called with the snapshot lock held.
+	 *
+	 * @return true if data holds valid topic data.
+	 */
+	bool copy_snapshot(uint64_t time_topic, void *data);
+
+	static Snapshot *get_snapshot(const orb_id_t topic, int instance);
+
+	static Snapshot *_snapshots;		///< list of all snapshots
+	static pthread_mutex_t _snapshots_mutex;	///< protects the list and the snapshot contents
+
 	const orb_id_t _topic;		///< topic metadata
 	const int _instance;		///< get topic instance
 	int _fd;			///< subscription handle
 	bool _published;		///< topic was ever published
+	Snapshot *_snapshot;		///< shared data, nullptr if allocation failed
 
 	/* do not allow copying this class */
 	MavlinkOrbSubscription(const MavlinkOrbSubscription&);
@@ -50,9 +50,18 @@
 ORB_DEFINE(uavcan_parameter_request, struct uavcan_parameter_request_s);
 ORB_DEFINE(uavcan_parameter_value, struct uavcan_parameter_value_s);
 #define HASH_PARAM "_HASH_CHECK"
+#define CHANGE_SEQ_PARAM "_CHANGE_SEQ"
+#define DIFF_PARAM "_DIFF_SINCE"
+#define DIFF_RESYNC_PARAM "_DIFF_RESYNC"
 
 MavlinkParametersManager::MavlinkParametersManager(Mavlink *mavlink) : MavlinkStream(mavlink),
 	_send_all_index(-1),
+	_send_diff(false),
+	_diff_since_seq(0),
+	_diff_end_seq(0),
+	_diff_end_pending(false),
+	_diff_resync(false),
+	_diff_resync_pending(false),
 	_rc_param_map_pub(nullptr),
 	_rc_param_map(),
 	_uavcan_parameter_request_pub(nullptr),
@@ -83,6 +92,9 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 					/* a restart should skip the hash check on the ground */
 					_send_all_index = 0;
 				}
+
+				_send_diff = false;
+				_diff_resync_pending = false;
 			}
 
 			if (req_list.target_system == mavlink_system.sysid && req_list.target_component < 127 &&
@@ -119,10 +131,25 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 				/* Whatever the value is, we're being told to stop sending */
 				if (strncmp(name, "_HASH_CHECK", sizeof(name)) == 0) {
 					_send_all_index = -1;
+					_send_diff = false;
+					_diff_resync_pending = false;
 					/* No other action taken, return */
 					return;
 				}
 
+				/* Send only the parameters changed after the sequence number in the value */
+				if (strncmp(name, DIFF_PARAM, sizeof(name)) == 0) {
+					memcpy(&_diff_since_seq, &set.param_value, sizeof(_diff_since_seq));
+					_diff_end_seq = param_change_seq();
+					_send_diff = true;
+
+					/* a sequence number from another boot cannot be compared, send everything */
+					_diff_resync = !param_change_seq_valid(_diff_since_seq);
+					_diff_resync_pending = _diff_resync;
+					_send_all_index = 0;
+					return;
+				}
+
 				/* attempt to find parameter, set and send it */
 				param_t param = param_find_no_notification(name);
 
@@ -179,16 +206,10 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 					/* XXX: I left this in so older versions of QGC wouldn't break */
 					if (strncmp(req_read.param_id, HASH_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) == 0) {
 						/* return hash check for cached params */
-						uint32_t hash = param_hash_check();
-
-						/* build the one-off response message */
-						mavlink_param_value_t msg;
-						msg.param_count = param_count_used();
-						msg.param_index = -1;
-						strncpy(msg.param_id, HASH_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
-						msg.param_type = MAV_PARAM_TYPE_UINT32;
-						memcpy(&msg.param_value, &hash, sizeof(hash));
-						_mavlink->send_message(MAVLINK_MSG_ID_PARAM_VALUE, &msg);
+						send_one_off(HASH_PARAM, param_hash_check());
+					} else if (strncmp(req_read.param_id, CHANGE_SEQ_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) == 0) {
+						/* return the sequence number a later diff request can refer to */
+						send_one_off(CHANGE_SEQ_PARAM, param_change_seq());
 					} else {
 						/* local name buffer to enforce null-terminated string */
 						char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1];
@@ -305,6 +326,14 @@ MavlinkParametersManager::send(const hrt_abstime t)
 			msg.param_type = MAVLINK_TYPE_INT32_T;
 		}
 		_mavlink->send_message(MAVLINK_MSG_ID_PARAM_VALUE, &msg, value.node_id);
+	} else if (_diff_resync_pending && space_available) {
+		/* announce that the following diff is a complete parameter list */
+		send_one_off(DIFF_RESYNC_PARAM, _diff_end_seq);
+		_diff_resync_pending = false;
+	} else if (_diff_end_pending && space_available) {
+		/* mark the end of a diff transfer with the sequence number it is complete up to */
+		send_one_off(CHANGE_SEQ_PARAM, _diff_end_seq);
+		_diff_end_pending = false;
 	} else if (_send_all_index >= 0 && _mavlink->boot_complete()) {
 		/* send all parameters if requested, but only after the system has booted */
 
@@ -318,16 +347,7 @@ MavlinkParametersManager::send(const hrt_abstime t)
 		 */
 		if (_send_all_index == PARAM_HASH) {
 			/* return hash check for cached params */
-			uint32_t hash = param_hash_check();
-
-			/* build the one-off response message */
-			mavlink_param_value_t msg;
-			msg.param_count = param_count_used();
-			msg.param_index = -1;
-			strncpy(msg.param_id, HASH_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
-			msg.param_type = MAV_PARAM_TYPE_UINT32;
-			memcpy(&msg.param_value, &hash, sizeof(hash));
-			_mavlink->send_message(MAVLINK_MSG_ID_PARAM_VALUE, &msg);
+			send_one_off(HASH_PARAM, param_hash_check());
 
 			/* after this we should start sending all params */
 			_send_all_index = 0;
@@ -336,13 +356,13 @@ MavlinkParametersManager::send(const hrt_abstime t)
 			return;
 		}
 
-		/* look for the first parameter which is used */
+		/* look for the first parameter which is used (and changed, when sending a diff) */
 		param_t p;
 		do {
 			/* walk through all parameters, including unused ones */
 			p = param_for_index(_send_all_index);
 			_send_all_index++;
-		} while (p != PARAM_INVALID && !param_used(p));
+		} while (p != PARAM_INVALID && (!param_used(p) || (_send_diff && !_diff_resync && !param_changed_since(p, _diff_since_seq))));
 
 		if (p != PARAM_INVALID) {
 			send_param(p);
@@ -350,6 +370,11 @@ MavlinkParametersManager::send(const hrt_abstime t)
 
 		if ((p == PARAM_INVALID) || (_send_all_index >= (int) param_count())) {
 			_send_all_index = -1;
+
+			if (_send_diff) {
+				_send_diff = false;
+				_diff_end_pending = true;
+			}
 		}
 	} else if (_send_all_index == PARAM_HASH && hrt_absolute_time() > 20 * 1000 * 1000) {
 		/* the boot did not seem to ever complete, warn user and set boot complete */
@@ -358,6 +383,19 @@ MavlinkParametersManager::send(const hrt_abstime t)
 	}
 }
 
+void
+MavlinkParametersManager::send_one_off(const char *name, uint32_t value)
+{
+	/* build the one-off response message */
+	mavlink_param_value_t msg;
+	msg.param_count = param_count_used();
+	msg.param_index = -1;
+	strncpy(msg.param_id, name, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+	msg.param_type = MAV_PARAM_TYPE_UINT32;
+	memcpy(&msg.param_value, &value, sizeof(value));
+	_mavlink->send_message(MAVLINK_MSG_ID_PARAM_VALUE, &msg);
+}
+
 int
 MavlinkParametersManager::send_param(param_t param)
 {
@@ -105,6 +105,13 @@ public:
 private:
 	int		_send_all_index;
 
+	bool		_send_diff;		///< only send parameters changed after _diff_since_seq
+	uint32_t	_diff_since_seq;
+	uint32_t	_diff_end_seq;		///< change sequence the running diff is complete up to
+	bool		_diff_end_pending;
+	bool		_diff_resync;		///< the diff request referred to another boot, send all parameters
+	bool		_diff_resync_pending;
+
 	/* do not allow top copying this class */
 	MavlinkParametersManager(MavlinkParametersManager &);
 	MavlinkParametersManager& operator = (const MavlinkParametersManager &);
@@ -116,6 +123,12 @@ protected:
 
 	int send_param(param_t param);
 
+	/**
+	 * Send a PARAM_VALUE that is not a parameter but carries a 32 bit value,
+	 * such as the parameter hash.
+	 */
+	void send_one_off(const char *name, uint32_t value);
+
 	orb_advert_t _rc_param_map_pub;
 	struct rc_parameter_map_s _rc_param_map;
 
@@ -89,7 +89,7 @@ static const float mg2ms2 = CONSTANTS_ONE_G / 1000.0f;
 
 MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_mavlink(parent),
-	status{},
+	_parser(mavlink_get_channel_status(parent->get_channel())),
 	hil_local_pos{},
 	hil_land_detector{},
 	_control_mode{},
@@ -1986,14 +1986,6 @@ MavlinkReceiver::receive_thread(void *arg)
 	px4_prctl(PR_SET_NAME, thread_name, getpid());
 
 	const int timeout = 500;
-#ifdef __PX4_POSIX
-	/* 1500 is the Wifi MTU, so we make sure to fit a full packet */
-	uint8_t buf[1600 * 5];
-#else
-	/* the serial port buffers internally as well, we just need to fit a small chunk */
-	uint8_t buf[64];
-#endif
-	mavlink_message_t msg;
 
 	struct pollfd fds[1];
 
@@ -2007,8 +1999,25 @@ MavlinkReceiver::receive_thread(void *arg)
 	}
 
 #ifdef __PX4_POSIX
-	struct sockaddr_in srcaddr = {};
-	socklen_t addrlen = sizeof(srcaddr);
+	struct sockaddr_in srcaddr[RX_BATCH_SIZE] = {};
+	socklen_t addrlen = sizeof(srcaddr[0]);
+	ssize_t datagram_len[RX_BATCH_SIZE] = {};
+
+#ifdef __PX4_LINUX
+	struct iovec iov[RX_BATCH_SIZE];
+	struct mmsghdr msgs[RX_BATCH_SIZE];
+	memset(msgs, 0, sizeof(msgs));
+
+	for (unsigned i = 0; i < RX_BATCH_SIZE; i++) {
+		iov[i].iov_base = rx_slot(i);
+		iov[i].iov_len = RX_SLOT_SIZE;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &srcaddr[i];
+		msgs[i].msg_hdr.msg_namelen = addrlen;
+	}
+
+#endif
 
 	if (_mavlink->get_protocol() == UDP || _mavlink->get_protocol() == TCP) {
 		// make sure mavlink app has booted before we start using the socket
@@ -2020,11 +2029,17 @@ MavlinkReceiver::receive_thread(void *arg)
 		fds[0].events = POLLIN;
 	}
 
+	int ndatagrams = 0;
 #endif
 	ssize_t nread = 0;
 
 	while (!_mavlink->_task_should_exit) {
 		if (poll(&fds[0], 1, timeout) > 0) {
+			nread = 0;
+#ifdef __PX4_POSIX
+			ndatagrams = 0;
+#endif
+
 			if (_mavlink->get_protocol() == SERIAL) {
 
 				/*
@@ -2033,18 +2048,49 @@ MavlinkReceiver::receive_thread(void *arg)
 				 */
 				const unsigned character_count = 20;
 
+				/* read straight into the parser, partial frames stay there until completed */
+				size_t space;
+				uint8_t *buf = _parser.get_stream_buffer(&space);
+
 				/* non-blocking read. read may return negative values */
-				if ((nread = ::read(uart_fd, buf, sizeof(buf))) < (ssize_t)character_count) {
+				if ((nread = ::read(uart_fd, buf, space)) < (ssize_t)character_count) {
 					unsigned sleeptime = (1.0f / (_mavlink->get_baudrate() / 10)) * character_count * 1000000;
 					usleep(sleeptime);
 				}
+
+				if (nread > 0) {
+					_parser.commit(nread);
+				}
 			}
 
 #ifdef __PX4_POSIX
 
 			if (_mavlink->get_protocol() == UDP) {
 				if (fds[0].revents & POLLIN) {
-					nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
+#ifdef __PX4_LINUX
+
+					/* fetch everything that is queued on the socket with a single syscall */
+					for (unsigned i = 0; i < RX_BATCH_SIZE; i++) {
+						msgs[i].msg_hdr.msg_namelen = addrlen;
+					}
+
+					ndatagrams = recvmmsg(_mavlink->get_socket_fd(), msgs, RX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+					for (int i = 0; i < ndatagrams; i++) {
+						datagram_len[i] = msgs[i].msg_len;
+						nread += msgs[i].msg_len;
+					}
+
+#else
+					datagram_len[0] = recvfrom(_mavlink->get_socket_fd(), rx_slot(0), RX_SLOT_SIZE, 0,
+								   (struct sockaddr *)&srcaddr[0], &addrlen);
+
+					if (datagram_len[0] > 0) {
+						nread = datagram_len[0];
+						ndatagrams = 1;
+					}
+
+#endif
 				}
 
 			} else {
@@ -2055,6 +2101,8 @@ MavlinkReceiver::receive_thread(void *arg)
 
 			int localhost = (127 << 24) + 1;
 
+			const int last = (ndatagrams > 0) ? ndatagrams - 1 : 0;
+
 			if (!_mavlink->get_client_source_initialized()) {
 
 				// set the address either if localhost or if 3 seconds have passed
@@ -2064,10 +2112,10 @@ MavlinkReceiver::receive_thread(void *arg)
 
 				if ((stime != 0 && (hrt_elapsed_time(&stime) > 3 * 1000 * 1000))
 				    || (srcaddr_last->sin_addr.s_addr == htonl(localhost))) {
-					srcaddr_last->sin_addr.s_addr = srcaddr.sin_addr.s_addr;
-					srcaddr_last->sin_port = srcaddr.sin_port;
+					srcaddr_last->sin_addr.s_addr = srcaddr[last].sin_addr.s_addr;
+					srcaddr_last->sin_port = srcaddr[last].sin_port;
 					_mavlink->set_client_source_initialized();
-					warnx("changing partner IP to: %s", inet_ntoa(srcaddr.sin_addr));
+					warnx("changing partner IP to: %s", inet_ntoa(srcaddr[last].sin_addr));
 				}
 			}
 
@@ -2075,21 +2123,27 @@ MavlinkReceiver::receive_thread(void *arg)
 			// only start accepting messages once we're sure who we talk to
 
 			if (_mavlink->get_client_source_initialized()) {
-				/* if read failed, this loop won't execute */
-				for (ssize_t i = 0; i < nread; i++) {
-					if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &status)) {
-						/* handle generic messages and commands */
-						handle_message(&msg);
-
-						/* handle packet with parent object */
-						_mavlink->handle_message(&msg);
-					}
+				if (_mavlink->get_protocol() == SERIAL) {
+					parse_and_dispatch();
 				}
 
+#ifdef __PX4_POSIX
+
+				for (int i = 0; i < ndatagrams; i++) {
+					_parser.set_datagram(rx_slot(i), datagram_len[i]);
+					parse_and_dispatch();
+				}
+
+#endif
+
 				/* count received bytes (nread will be -1 on read error) */
 				if (nread > 0) {
 					_mavlink->count_rxbytes(nread);
 				}
+
+			} else {
+				/* drop anything received before we know our partner */
+				_parser.discard();
 			}
 		}
 	}
@@ -2097,6 +2151,21 @@ MavlinkReceiver::receive_thread(void *arg)
 	return nullptr;
 }
 
+void
+MavlinkReceiver::parse_and_dispatch()
+{
+	mavlink_message_t *msg;
+
+	/* messages point into the receive buffer, they are only valid until the next call */
+	while ((msg = _parser.next()) != nullptr) {
+		/* handle generic messages and commands */
+		handle_message(msg);
+
+		/* handle packet with parent object */
+		_mavlink->handle_message(msg);
+	}
+}
+
 void MavlinkReceiver::print_status()
 {
 
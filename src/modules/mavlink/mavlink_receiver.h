@@ -79,6 +79,7 @@
 #include <uORB/topics/gps_inject_data.h>
 
 #include "mavlink_ftp.h"
+#include "mavlink_frame_parser.h"
 
 #define PX4_EPOCH_SECS 1234567890ULL
 
@@ -145,6 +146,11 @@ private:
 
 	void *receive_thread(void *arg);
 
+	/**
+	 * Run all complete frames the parser holds through the message handlers
+	 */
+	void parse_and_dispatch();
+
 	/**
 	 * Convert remote timestamp to local hrt time (usec)
 	 * Use timesync if available, monotonic boot time otherwise
@@ -169,7 +175,21 @@ private:
 	bool	evaluate_target_ok(int command, int target_system, int target_component);
 
 	Mavlink	*_mavlink;
-	mavlink_status_t status;
+	MavlinkFrameParser _parser;
+
+#ifdef __PX4_POSIX
+	/* 1500 is the Wifi MTU, so we make sure to fit a full packet */
+	static constexpr size_t RX_SLOT_SIZE = 1600;
+	/* maximum number of datagrams fetched per receive call */
+	static constexpr unsigned RX_BATCH_SIZE = 8;
+	static constexpr size_t RX_SLOT_WORDS = (MavlinkFrameParser::HEADROOM + RX_SLOT_SIZE + 7) / 8;
+
+	/* one slot per datagram, each aligned for in-place parsing */
+	uint64_t _rx_slots[RX_BATCH_SIZE][RX_SLOT_WORDS];
+
+	uint8_t *rx_slot(unsigned i) { return (uint8_t *)_rx_slots[i] + MavlinkFrameParser::HEADROOM; }
+#endif
+
 	struct vehicle_local_position_s hil_local_pos;
 	struct vehicle_land_detected_s hil_land_detector;
 	struct vehicle_control_mode_s _control_mode;
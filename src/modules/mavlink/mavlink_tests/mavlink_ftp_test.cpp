@@ -554,6 +554,105 @@ bool MavlinkFtpTest::_burst_test(void)
 	return true;
 }
 
+/// @brief Tests windowed burst download and selective retransmit of a chunk.
+bool MavlinkFtpTest::_burst_window_test(void)
+{
+	MavlinkFTP::PayloadHeader		payload;
+	const MavlinkFTP::PayloadHeader		*reply;
+	WindowInfo				window_info;
+	struct stat				st;
+
+	// Use the test case which needs two packets
+	const DownloadTestCase *test = &_rgDownloadTestCases[2];
+
+	// Test file spans two packets, so it always fits in two payloads worth of data
+	uint8_t bytes[2 * MavlinkFTP::kMaxDataLength];
+
+	ut_compare("stat failed", stat(test->file, &st), 0);
+	ut_assert("Test file too large", st.st_size <= (off_t)sizeof(bytes));
+	int fd = ::open(test->file, O_RDONLY);
+	ut_assert("open failed", fd != -1);
+	int bytes_read = ::read(fd, bytes, st.st_size);
+	ut_compare("read failed", bytes_read, st.st_size);
+	::close(fd);
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+
+	bool success = _send_receive_msg(&payload,		// FTP payload header
+					 strlen(test->file)+1,	// size in bytes of data
+					 (uint8_t*)test->file,	// Data to start into FTP message payload
+					 &reply);		// Payload inside FTP message response
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	uint8_t session = reply->session;
+
+	window_info.ftp_test_class = this;
+	window_info.file_size = st.st_size;
+	window_info.file_bytes = bytes;
+	window_info.data_packets = 0;
+	window_info.last_offset = 0;
+	window_info.eof = false;
+	window_info.failed = false;
+	_ftp_server->set_unittest_worker(MavlinkFtpTest::receive_message_handler_window, &window_info);
+
+	// Request the burst with a window larger than the file, everything goes out in one cycle
+	uint32_t window = st.st_size * 2;
+	payload.opcode = MavlinkFTP::kCmdBurstReadFile;
+	payload.session = session;
+	payload.offset = 0;
+
+	mavlink_message_t msg;
+	_setup_ftp_msg(&payload, sizeof(window), (uint8_t*)&window, &msg);
+	_ftp_server->handle_message(&msg);
+
+	hrt_abstime t = 0;
+	_ftp_server->send(t);
+
+	ut_assert("Unexpected packet", !window_info.failed);
+	ut_compare("Incorrect number of data packets", window_info.data_packets, 2);
+	ut_assert("Missing Nak EOF", window_info.eof);
+
+	// Nothing more may be sent until the client asks for it
+	window_info.data_packets = 0;
+	_ftp_server->send(t);
+	ut_compare("Packets sent without request", window_info.data_packets, 0);
+
+	// Ack everything but the first chunk, which has to come again
+	uint32_t missing = 0;
+	payload.opcode = MavlinkFTP::kCmdBurstAck;
+	payload.session = session;
+	payload.offset = st.st_size;
+	_setup_ftp_msg(&payload, sizeof(missing), (uint8_t*)&missing, &msg);
+	_ftp_server->handle_message(&msg);
+	_ftp_server->send(t);
+
+	ut_assert("Unexpected packet", !window_info.failed);
+	ut_compare("Incorrect number of retransmits", window_info.data_packets, 1);
+	ut_compare("Incorrect retransmit offset", window_info.last_offset, 0);
+
+	_ftp_server->set_unittest_worker(MavlinkFtpTest::receive_message_handler_generic, this);
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = session;
+	payload.offset = 0;
+
+	success = _send_receive_msg(&payload,	// FTP payload header
+				    0,		// size in bytes of data
+				    nullptr,	// Data to start into FTP message payload
+				    &reply);	// Payload inside FTP message response
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 /// @brief Tests for correct reponse to a Read command on an invalid session.
 bool MavlinkFtpTest::_read_badsession_test(void)
 {
@@ -813,6 +912,35 @@ bool MavlinkFtpTest::_receive_message_handler_burst(const mavlink_file_transfer_
 	return true;
 }
 
+/// Static method used as callback from MavlinkFTP for windowed burst testing.
+void MavlinkFtpTest::receive_message_handler_window(const mavlink_file_transfer_protocol_t* ftp_req, void *worker_data)
+{
+	WindowInfo* window_info = (WindowInfo*)worker_data;
+	window_info->ftp_test_class->_receive_message_handler_window(ftp_req, window_info);
+}
+
+void MavlinkFtpTest::_receive_message_handler_window(const mavlink_file_transfer_protocol_t* ftp_msg, WindowInfo* window_info)
+{
+	// Sequence numbers are not checked, retransmits continue the stream sequence
+	const MavlinkFTP::PayloadHeader* reply = reinterpret_cast<const MavlinkFTP::PayloadHeader*>(ftp_msg->payload);
+
+	if (reply->req_opcode != MavlinkFTP::kCmdBurstReadFile) {
+		window_info->failed = true;
+
+	} else if (reply->opcode == MavlinkFTP::kRspNak) {
+		window_info->eof = reply->data[0] == MavlinkFTP::kErrEOF && reply->offset == window_info->file_size;
+		window_info->failed |= !window_info->eof;
+
+	} else if (reply->offset + reply->size > window_info->file_size ||
+		   memcmp(reply->data, &window_info->file_bytes[reply->offset], reply->size) != 0) {
+		window_info->failed = true;
+
+	} else {
+		window_info->data_packets++;
+		window_info->last_offset = reply->offset;
+	}
+}
+
 /// @brief Decode and validate the incoming message
 bool MavlinkFtpTest::_decode_message(const mavlink_file_transfer_protocol_t	*ftp_msg,	///< Incoming FTP message
 				     const MavlinkFTP::PayloadHeader		**payload)	///< Payload inside FTP message response
@@ -897,6 +1025,7 @@ bool MavlinkFtpTest::run_tests(void)
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
 	ut_run_test(_burst_test);
+	ut_run_test(_burst_window_test);
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
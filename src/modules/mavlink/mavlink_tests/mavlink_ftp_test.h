@@ -60,7 +60,20 @@ public:
 	};
 	
 	static void receive_message_handler_burst(const mavlink_file_transfer_protocol_t* ftp_req, void *worker_data);
-	
+
+	/// Worker data for windowed burst handler
+	struct WindowInfo {
+		MavlinkFtpTest*		ftp_test_class;
+		uint32_t		file_size;
+		uint8_t*		file_bytes;
+		unsigned		data_packets;	///< Number of Acks with file data received
+		uint32_t		last_offset;	///< Offset of the last data packet
+		bool			eof;		///< Nak EOF received
+		bool			failed;		///< Unexpected packet received
+	};
+
+	static void receive_message_handler_window(const mavlink_file_transfer_protocol_t* ftp_req, void *worker_data);
+
 	static const uint8_t serverSystemId = 50;	///< System ID for server
 	static const uint8_t serverComponentId = 1;	///< Component ID for server
 	static const uint8_t serverChannel = 0;		///< Channel to send to
@@ -87,6 +100,7 @@ private:
 	bool _read_test(void);
 	bool _read_badsession_test(void);
 	bool _burst_test(void);
+	bool _burst_window_test(void);
 	bool _removedirectory_test(void);
 	bool _createdirectory_test(void);
 	bool _removefile_test(void);
@@ -120,7 +134,8 @@ private:
 	};
 	
 	bool _receive_message_handler_burst(const mavlink_file_transfer_protocol_t* ftp_req, BurstInfo* burst_info);
-	
+	void _receive_message_handler_window(const mavlink_file_transfer_protocol_t* ftp_req, WindowInfo* window_info);
+
 	MavlinkFTP*	_ftp_server;
 	uint16_t	_expected_seq_number;
 	
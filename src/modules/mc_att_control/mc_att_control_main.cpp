@@ -147,6 +147,7 @@ private:
 	orb_id_t _actuators_id;	/**< pointer to correct actuator controls0 uORB metadata structure */
 
 	bool		_actuators_0_circuit_breaker_enabled;	/**< circuit breaker to suppress output */
+	uint32_t	_params_seq;		/**< parameter change sequence of the local parameter cache */
 
 	struct control_state_s				_ctrl_state;		/**< control state */
 	struct vehicle_attitude_setpoint_s	_v_att_sp;			/**< vehicle attitude setpoint */
@@ -171,6 +172,7 @@ private:
 
 	math::Matrix<3, 3>  _I;				/**< identity matrix */
 
+	/* only param_t members, parameter_update_poll() checks the struct as an array of handles */
 	struct {
 		param_t roll_p;
 		param_t roll_rate_p;
@@ -203,6 +205,7 @@ private:
 		param_t pitch_tc;
 		param_t vtol_opt_recovery_enabled;
 		param_t vtol_wv_yaw_rate_scale;
+		param_t cbrk_rate_ctrl;
 
 	}		_params_handles;		/**< handles for interesting parameters */
 
@@ -323,6 +326,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	_actuators_id(0),
 
 	_actuators_0_circuit_breaker_enabled(false),
+	_params_seq(0),
 
 	/* performance counters */
 	_loop_perf(perf_alloc(PC_ELAPSED, "mc_att_control")),
@@ -397,6 +401,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	_params_handles.pitch_tc		= 	param_find("MC_PITCH_TC");
 	_params_handles.vtol_opt_recovery_enabled	= param_find("VT_OPT_RECOV_EN");
 	_params_handles.vtol_wv_yaw_rate_scale		= param_find("VT_WV_YAWR_SCL");
+	_params_handles.cbrk_rate_ctrl	=	param_find("CBRK_RATE_CTRL");
 
 
 
@@ -446,6 +451,8 @@ MulticopterAttitudeControl::parameters_update()
 
 	float roll_tc, pitch_tc;
 
+	_params_seq = param_change_seq();
+
 	param_get(_params_handles.roll_tc, &roll_tc);
 	param_get(_params_handles.pitch_tc, &pitch_tc);
 
@@ -538,7 +545,15 @@ MulticopterAttitudeControl::parameter_update_poll()
 	if (updated) {
 		struct parameter_update_s param_update;
 		orb_copy(ORB_ID(parameter_update), _params_sub, &param_update);
-		parameters_update();
+
+		/* the update is sent for any parameter, skip the reload if none of ours changed */
+		static_assert(sizeof(_params_handles) % sizeof(param_t) == 0,
+			      "_params_handles must only hold param_t members");
+
+		if (param_any_changed_since((const param_t *)&_params_handles,
+					    sizeof(_params_handles) / sizeof(param_t), _params_seq)) {
+			parameters_update();
+		}
 	}
 }
 
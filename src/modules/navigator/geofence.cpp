@@ -74,6 +74,14 @@ Geofence::Geofence(Navigator *navigator) :
 	_altitude_min(0),
 	_altitude_max(0),
 	_vertices_count(0),
+	_update_requested(false),
+	_requested_vertices_count(0),
+	_requested_altitude_min(0),
+	_requested_altitude_max(0),
+	_zones(),
+	_zones_failed(false),
+	_boundary_distance(NAN),
+	_version(0),
 	_param_action(this, "ACTION"),
 	_param_altitude_mode(this, "ALTMODE"),
 	_param_source(this, "SOURCE"),
@@ -134,6 +142,8 @@ bool Geofence::inside(const struct vehicle_global_position_s &global_position,
 
 bool Geofence::inside(double lat, double lon, float altitude)
 {
+		_boundary_distance = _zones.boundary_distance(lat, lon);
+
 		int32_t max_horizontal_distance = _param_max_hor_distance.get();
 		int32_t max_vertical_distance = _param_max_ver_distance.get();
 
@@ -190,71 +200,29 @@ bool Geofence::inside(double lat, double lon, float altitude)
 
 bool Geofence::inside_polygon(double lat, double lon, float altitude)
 {
-	if (valid()) {
-
-		if (!isEmpty()) {
-			/* Vertical check */
-			if (altitude > _altitude_max || altitude < _altitude_min) {
-				return false;
-			}
-
-			/*Horizontal check */
-			/* Adaptation of algorithm originally presented as
-			 * PNPOLY - Point Inclusion in Polygon Test
-			 * W. Randolph Franklin (WRF) */
-
-			bool c = false;
-
-			struct fence_vertex_s temp_vertex_i;
-			struct fence_vertex_s temp_vertex_j;
-
-			/* Red until fence is finished */
-			for (unsigned i = 0, j = _vertices_count - 1; i < _vertices_count; j = i++) {
-				if (dm_read(DM_KEY_FENCE_POINTS, i, &temp_vertex_i, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
-
-				if (dm_read(DM_KEY_FENCE_POINTS, j, &temp_vertex_j, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
-
-				// skip vertex 0 (return point)
-				if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-				    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-				     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-					c = !c;
-				}
-
-			}
-
-			return c;
-
-		} else {
-			/* Empty fence --> accept all points */
-			return true;
-		}
-
-	} else {
-		/* Invalid fence --> accept all points */
+	if (isEmpty()) {
+		/* Empty fence --> accept all points */
 		return true;
 	}
-}
 
-bool
-Geofence::valid()
-{
-	// NULL fence is valid
-	if (isEmpty()) {
-		return true;
+	if (!valid()) {
+		/* Fence that could not be loaded --> reject all points */
+		return false;
 	}
 
-	// Otherwise
-	if ((_vertices_count < 4) || (_vertices_count > fence_s::GEOFENCE_MAX_VERTICES)) {
-		warnx("Fence must have at least 3 sides and not more than %d", fence_s::GEOFENCE_MAX_VERTICES - 1);
+	/* Vertical check */
+	if (altitude > _altitude_max || altitude < _altitude_min) {
 		return false;
 	}
 
-	return true;
+	/*Horizontal check */
+	return _zones.inside(lat, lon);
+}
+
+bool
+Geofence::valid()
+{
+	return !_zones_failed;
 }
 
 void
@@ -262,11 +230,11 @@ Geofence::addPoint(int argc, char *argv[])
 {
 	int ix, last;
 	double lon, lat;
-	struct fence_vertex_s vertex;
+	struct fence_vertex_s vertex = {};
 	char *end;
 
 	if ((argc == 1) && (strcmp("-clear", argv[0]) == 0)) {
-		dm_clear(DM_KEY_FENCE_POINTS);
+		clearDm();
 		publishFence(0);
 		return;
 	}
@@ -295,6 +263,7 @@ Geofence::addPoint(int argc, char *argv[])
 
 	if (dm_write(DM_KEY_FENCE_POINTS, ix, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) == sizeof(vertex)) {
 		if (last) {
+			requestUpdate(ix + 1);
 			publishFence((unsigned)ix + 1);
 		}
 
@@ -323,6 +292,11 @@ Geofence::loadFromFile(const char *filename)
 	int			pointCounter = 0;
 	bool		gotVertical = false;
 	const char commentChar = '#';
+	uint8_t		zoneType = fence_vertex_s::ZONE_POLYGON_INCLUSION;
+	int			zoneStart = -1;
+	struct fence_vertex_s zoneFirst = {};
+	float altitudeMin = 0.0f;
+	float altitudeMax = 0.0f;
 	int rc = ERROR;
 
 	/* Make sure no data is left in the datamanager */
@@ -359,7 +333,60 @@ Geofence::loadFromFile(const char *filename)
 
 		if (gotVertical) {
 			/* Parse the line as a geofence point */
-			struct fence_vertex_s vertex;
+			struct fence_vertex_s vertex = {};
+
+			/* POLYGON INCLUSION|EXCLUSION starts a new polygon, the points before the first one form an inclusion polygon */
+			if (strncmp(&line[textStart], "POLYGON", 7) == 0 || strncmp(&line[textStart], "CIRCLE", 6) == 0) {
+				char kind[16];
+
+				if (zoneStart >= 0 && finishZone(zoneStart, zoneFirst, pointCounter) != OK) {
+					goto error;
+				}
+
+				zoneStart = -1;
+
+				if (sscanf(&line[textStart], "POLYGON %15s", kind) == 1) {
+					if (strcmp(kind, "INCLUSION") == 0) {
+						zoneType = fence_vertex_s::ZONE_POLYGON_INCLUSION;
+
+					} else if (strcmp(kind, "EXCLUSION") == 0) {
+						zoneType = fence_vertex_s::ZONE_POLYGON_EXCLUSION;
+
+					} else {
+						warnx("Unknown geofence polygon type %s", kind);
+						goto error;
+					}
+
+					continue;
+				}
+
+				/* CIRCLE INCLUSION|EXCLUSION latitude longitude radius is a complete zone */
+				if (sscanf(&line[textStart], "CIRCLE %15s %f %f %f", kind, &vertex.lat, &vertex.lon, &vertex.radius) != 4) {
+					warnx("Scanf to parse geofence circle failed.");
+					goto error;
+				}
+
+				if (strcmp(kind, "INCLUSION") == 0) {
+					vertex.zone_type = fence_vertex_s::ZONE_CIRCLE_INCLUSION;
+
+				} else if (strcmp(kind, "EXCLUSION") == 0) {
+					vertex.zone_type = fence_vertex_s::ZONE_CIRCLE_EXCLUSION;
+
+				} else {
+					warnx("Unknown geofence circle type %s", kind);
+					goto error;
+				}
+
+				if (dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex)) {
+					goto error;
+				}
+
+				warnx("Geofence: circle: %d, lat %.5f: lon: %.5f, radius: %.1f", pointCounter, (double)vertex.lat,
+				      (double)vertex.lon, (double)vertex.radius);
+
+				pointCounter++;
+				continue;
+			}
 
 			/* if the line starts with DMS, this means that the coordinate is given as degree minute second instead of decimal degrees */
 			if (line[textStart] == 'D' && line[textStart + 1] == 'M' && line[textStart + 2] == 'S') {
@@ -384,6 +411,13 @@ Geofence::loadFromFile(const char *filename)
 				}
 			}
 
+			vertex.zone_type = zoneType;
+
+			if (zoneStart < 0) {
+				zoneStart = pointCounter;
+				zoneFirst = vertex;
+			}
+
 			if (dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex)) {
 				goto error;
 			}
@@ -394,18 +428,24 @@ Geofence::loadFromFile(const char *filename)
 
 		} else {
 			/* Parse the line as the vertical limits */
-			if (sscanf(line, "%f %f", &_altitude_min, &_altitude_max) != 2) {
+			if (sscanf(line, "%f %f", &altitudeMin, &altitudeMax) != 2) {
 				goto error;
 			}
 
-			warnx("Geofence: alt min: %.4f, alt_max: %.4f", (double)_altitude_min, (double)_altitude_max);
+			warnx("Geofence: alt min: %.4f, alt_max: %.4f", (double)altitudeMin, (double)altitudeMax);
 			gotVertical = true;
 		}
 	}
 
+	if (zoneStart >= 0 && finishZone(zoneStart, zoneFirst, pointCounter) != OK) {
+		goto error;
+	}
+
 	/* Check if import was successful */
 	if (gotVertical && pointCounter > 0) {
-		_vertices_count = pointCounter;
+		_requested_altitude_min = altitudeMin;
+		_requested_altitude_max = altitudeMax;
+		requestUpdate(pointCounter);
 		warnx("Geofence: imported successfully");
 		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Geofence imported");
 		rc = OK;
@@ -423,5 +463,67 @@ error:
 int Geofence::clearDm()
 {
 	dm_clear(DM_KEY_FENCE_POINTS);
+	requestUpdate(0);
+	return OK;
+}
+
+void Geofence::requestUpdate(unsigned vertex_count)
+{
+	_requested_vertices_count = vertex_count;
+	_update_requested = true;
+}
+
+void Geofence::update()
+{
+	if (!_update_requested) {
+		return;
+	}
+
+	_update_requested = false;
+	_vertices_count = _requested_vertices_count;
+	_altitude_min = _requested_altitude_min;
+	_altitude_max = _requested_altitude_max;
+	updateZones();
+}
+
+void Geofence::updateZones()
+{
+	_zones.clear();
+	_zones_failed = false;
+	_version++;
+
+	if (_vertices_count == 0) {
+		return;
+	}
+
+	/* too large for the stack of the navigator task */
+	struct fence_vertex_s *vertices = nullptr;
+
+	if (_vertices_count <= DM_KEY_FENCE_POINTS_MAX) {
+		vertices = new fence_vertex_s[_vertices_count];
+	}
+
+	/* a fence that cannot be loaded is violated everywhere instead of being ignored */
+	if (vertices == nullptr ||
+	    dm_read_range(DM_KEY_FENCE_POINTS, 0, _vertices_count, vertices, sizeof(struct fence_vertex_s)) !=
+	    (ssize_t)_vertices_count || !_zones.build(vertices, _vertices_count)) {
+		_zones_failed = true;
+		mavlink_and_console_log_critical(_navigator->get_mavlink_log_pub(),
+						 "Geofence invalid: polygons need 3 or more sides, at most %d vertices",
+						 DM_KEY_FENCE_POINTS_MAX);
+	}
+
+	delete[] vertices;
+}
+
+int Geofence::finishZone(int first_index, struct fence_vertex_s &first_vertex, int end_index)
+{
+	first_vertex.vertex_count = end_index - first_index;
+
+	if (dm_write(DM_KEY_FENCE_POINTS, first_index, DM_PERSIST_POWER_ON_RESET, &first_vertex,
+		     sizeof(first_vertex)) != sizeof(first_vertex)) {
+		return ERROR;
+	}
+
 	return OK;
 }
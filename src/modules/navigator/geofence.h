@@ -51,6 +51,8 @@
 #include <drivers/drv_hrt.h>
 #include <px4_defines.h>
 
+#include "geofence_zones.h"
+
 #define GEOFENCE_FILENAME PX4_ROOTFSDIR"/fs/microsd/etc/geofence.txt"
 
 class Navigator;
@@ -88,6 +90,9 @@ public:
 
 	int clearDm();
 
+	/**
+	 * Return false if the stored fence could not be loaded, no position is inside then.
+	 */
 	bool valid();
 
 	/**
@@ -107,6 +112,24 @@ public:
 
 	int getGeofenceAction() { return _param_action.get(); }
 
+	/**
+	 * Rebuild the zones if the fence was changed with addPoint(), loadFromFile() or clearDm().
+	 *
+	 * Those are also called from the shell, so they only store the vertices and request
+	 * the rebuild. Must be called from the navigator task, which is the only user of the zones.
+	 */
+	void update();
+
+	/**
+	 * Distance of the last checked position to the closest zone boundary in meters, NAN without zones.
+	 */
+	float getBoundaryDistance() { return _boundary_distance; }
+
+	/**
+	 * Incremented whenever the zones change, e.g. to know when results depending on the fence are stale.
+	 */
+	unsigned getVersion() { return _version; }
+
 private:
 	Navigator	*_navigator;
 
@@ -123,6 +146,17 @@ private:
 
 	unsigned _vertices_count;
 
+	/* fence requested by addPoint(), loadFromFile() or clearDm(), applied by update() */
+	volatile bool _update_requested;
+	unsigned _requested_vertices_count;
+	float _requested_altitude_min;
+	float _requested_altitude_max;
+
+	GeofenceZones _zones;				/**< fence vertices prepared for the horizontal check */
+	bool _zones_failed;				/**< the stored fence could not be loaded */
+	float _boundary_distance;
+	unsigned _version;
+
 	/* Params */
 	control::BlockParamInt _param_action;
 	control::BlockParamInt _param_altitude_mode;
@@ -136,6 +170,21 @@ private:
 	bool inside(double lat, double lon, float altitude);
 	bool inside(const struct vehicle_global_position_s &global_position);
 	bool inside(const struct vehicle_global_position_s &global_position, float baro_altitude_amsl);
+
+	/**
+	 * Rebuild the zones from the vertices in the dataman.
+	 */
+	void updateZones();
+
+	/**
+	 * Let update() apply a fence of vertex_count vertices stored in the dataman.
+	 */
+	void requestUpdate(unsigned vertex_count);
+
+	/**
+	 * Store the vertex count of a zone read from file on its first vertex.
+	 */
+	int finishZone(int first_index, struct fence_vertex_s &first_vertex, int end_index);
 };
 
 
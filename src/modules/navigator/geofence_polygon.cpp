@@ -0,0 +1,298 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file geofence_polygon.cpp
+ * Geofence polygon held in RAM, with an edge table in a local frame.
+ */
+
+#include "geofence_polygon.h"
+
+#include <math.h>
+#include <px4_defines.h>
+#include <geo/geo.h>
+#include <mathlib/mathlib.h>
+
+/* Limit for the number of bands, a band holds about one edge on average up to here */
+static constexpr unsigned MAX_BANDS = 64;
+
+GeofencePolygon::GeofencePolygon() :
+	_ref_lat(0.0),
+	_ref_lon(0.0),
+	_north_scale(0.0f),
+	_east_scale(0.0f),
+	_north_min(0.0f),
+	_north_max(0.0f),
+	_east_min(0.0f),
+	_east_max(0.0f),
+	_vertices(nullptr),
+	_vertex_count(0),
+	_edges(nullptr),
+	_edge_count(0),
+	_band_start(nullptr),
+	_band_edges(nullptr),
+	_band_count(0),
+	_band_scale(0.0f)
+{
+}
+
+GeofencePolygon::~GeofencePolygon()
+{
+	clear();
+}
+
+void
+GeofencePolygon::clear()
+{
+	delete[] _vertices;
+	delete[] _edges;
+	delete[] _band_start;
+	delete[] _band_edges;
+
+	_vertices = nullptr;
+	_vertex_count = 0;
+	_edges = nullptr;
+	_band_start = nullptr;
+	_band_edges = nullptr;
+	_edge_count = 0;
+	_band_count = 0;
+}
+
+void
+GeofencePolygon::project(double lat, double lon, float &north, float &east) const
+{
+	/* linear in lat/lon, the differences are small enough for single precision */
+	north = (float)(lat - _ref_lat) * _north_scale;
+	east = (float)(lon - _ref_lon) * _east_scale;
+}
+
+unsigned
+GeofencePolygon::band(float east) const
+{
+	int k = (int)((east - _east_min) * _band_scale);
+
+	if (k < 0) {
+		return 0;
+	}
+
+	if (k >= (int)_band_count) {
+		return _band_count - 1;
+	}
+
+	return k;
+}
+
+bool
+GeofencePolygon::build(const struct fence_vertex_s *vertices, unsigned count)
+{
+	clear();
+
+	if (vertices == nullptr || count < 3 || count > UINT16_MAX) {
+		return false;
+	}
+
+	_ref_lat = vertices[0].lat;
+	_ref_lon = vertices[0].lon;
+	_north_scale = (float)(M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH);
+	_east_scale = (float)(M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH * cos(_ref_lat * M_DEG_TO_RAD));
+
+	_vertices = new Vertex[count];
+	_edges = new Edge[count];
+
+	if (_vertices == nullptr || _edges == nullptr) {
+		clear();
+		return false;
+	}
+
+	float north_prev, east_prev;
+	project(vertices[count - 1].lat, vertices[count - 1].lon, north_prev, east_prev);
+
+	_north_min = _north_max = north_prev;
+	_east_min = _east_max = east_prev;
+
+	for (unsigned i = 0; i < count; i++) {
+		float north, east;
+		project(vertices[i].lat, vertices[i].lon, north, east);
+
+		if (!PX4_ISFINITE(north) || !PX4_ISFINITE(east)) {
+			clear();
+			return false;
+		}
+
+		_vertices[i].north = north;
+		_vertices[i].east = east;
+
+		_north_min = fminf(_north_min, north);
+		_north_max = fmaxf(_north_max, north);
+		_east_min = fminf(_east_min, east);
+		_east_max = fmaxf(_east_max, east);
+
+		/* edges along a meridian are never crossed by the ray */
+		if (east != east_prev) {
+			Edge &edge = _edges[_edge_count++];
+			const bool west_first = east_prev < east;
+
+			edge.east_min = west_first ? east_prev : east;
+			edge.east_max = west_first ? east : east_prev;
+			edge.north_at_min = west_first ? north_prev : north;
+			edge.slope = (north - north_prev) / (east - east_prev);
+		}
+
+		north_prev = north;
+		east_prev = east;
+	}
+
+	_vertex_count = count;
+
+	if (_edge_count == 0) {
+		clear();
+		return false;
+	}
+
+	_band_count = (_edge_count < MAX_BANDS) ? _edge_count : MAX_BANDS;
+	_band_scale = _band_count / (_east_max - _east_min);
+	_band_start = new uint32_t[_band_count + 1];
+
+	if (_band_start == nullptr) {
+		clear();
+		return false;
+	}
+
+	/* count the edges per band, an edge is in every band its east range touches */
+	for (unsigned k = 0; k <= _band_count; k++) {
+		_band_start[k] = 0;
+	}
+
+	for (unsigned i = 0; i < _edge_count; i++) {
+		for (unsigned k = band(_edges[i].east_min); k <= band(_edges[i].east_max); k++) {
+			_band_start[k + 1]++;
+		}
+	}
+
+	for (unsigned k = 0; k < _band_count; k++) {
+		_band_start[k + 1] += _band_start[k];
+	}
+
+	_band_edges = new uint16_t[_band_start[_band_count]];
+
+	if (_band_edges == nullptr) {
+		clear();
+		return false;
+	}
+
+	/* fill the bands, using the start of the following band as cursor */
+	for (unsigned i = 0; i < _edge_count; i++) {
+		for (unsigned k = band(_edges[i].east_min); k <= band(_edges[i].east_max); k++) {
+			_band_edges[_band_start[k]++] = i;
+		}
+	}
+
+	for (unsigned k = _band_count; k > 0; k--) {
+		_band_start[k] = _band_start[k - 1];
+	}
+
+	_band_start[0] = 0;
+
+	return true;
+}
+
+bool
+GeofencePolygon::inside(double lat, double lon) const
+{
+	if (_edge_count == 0) {
+		return false;
+	}
+
+	float north, east;
+	project(lat, lon, north, east);
+
+	/* nothing is inside outside of the bounding box, this also rejects NaN */
+	if (!(east > _east_min && east <= _east_max && north >= _north_min && north <= _north_max)) {
+		return false;
+	}
+
+	/* Adaptation of algorithm originally presented as
+	 * PNPOLY - Point Inclusion in Polygon Test
+	 * W. Randolph Franklin (WRF),
+	 * casting the ray only against the edges in the band of the point */
+	const unsigned k = band(east);
+	bool c = false;
+
+	for (uint32_t n = _band_start[k]; n < _band_start[k + 1]; n++) {
+		const Edge &edge = _edges[_band_edges[n]];
+
+		if (east > edge.east_min && east <= edge.east_max &&
+		    north <= edge.north_at_min + edge.slope * (east - edge.east_min)) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
+
+float
+GeofencePolygon::distance(double lat, double lon) const
+{
+	if (_edge_count == 0) {
+		return NAN;
+	}
+
+	float north, east;
+	project(lat, lon, north, east);
+
+	float min_dist2 = INFINITY;
+
+	for (unsigned i = 0, j = _vertex_count - 1; i < _vertex_count; j = i++) {
+		const float seg_north = _vertices[i].north - _vertices[j].north;
+		const float seg_east = _vertices[i].east - _vertices[j].east;
+		const float seg_len2 = seg_north * seg_north + seg_east * seg_east;
+
+		/* position of the closest point along the edge */
+		float t = 0.0f;
+
+		if (seg_len2 > 0.0f) {
+			t = ((north - _vertices[j].north) * seg_north + (east - _vertices[j].east) * seg_east) / seg_len2;
+			t = math::constrain(t, 0.0f, 1.0f);
+		}
+
+		const float d_north = _vertices[j].north + t * seg_north - north;
+		const float d_east = _vertices[j].east + t * seg_east - east;
+		const float dist2 = d_north * d_north + d_east * d_east;
+
+		if (dist2 < min_dist2) {
+			min_dist2 = dist2;
+		}
+	}
+
+	return sqrtf(min_dist2);
+}
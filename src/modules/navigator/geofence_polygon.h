@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file geofence_polygon.h
+ * Geofence polygon held in RAM, with an edge table in a local frame.
+ */
+
+#ifndef GEOFENCE_POLYGON_H_
+#define GEOFENCE_POLYGON_H_
+
+#include <stdint.h>
+#include <uORB/topics/fence_vertex.h>
+
+/**
+ * Polygon for point-in-polygon checks against a fence given in lat/lon.
+ *
+ * The vertices are mapped into a local frame in meters around the first
+ * vertex. The mapping is linear in lat/lon, so the edges are exactly the
+ * lat/lon edges of the original fence. Every edge stores its east range,
+ * its north position at the western end and its slope. The edges are
+ * sorted into bands along the east axis. A check only casts its ray
+ * against the edges of one band, after a bounding box test.
+ *
+ * The vertices are kept in the local frame as well, for distance queries.
+ */
+class GeofencePolygon
+{
+public:
+	GeofencePolygon();
+	~GeofencePolygon();
+
+	/**
+	 * Replace the polygon.
+	 *
+	 * @param vertices	Fence vertices, the polygon is closed implicitly.
+	 * @param count		Number of vertices.
+	 * @return		false if there are less than 3 vertices or the tables cannot be allocated,
+	 *			the polygon is empty then.
+	 */
+	bool build(const struct fence_vertex_s *vertices, unsigned count);
+
+	void clear();
+
+	bool empty() const { return _edge_count == 0; }
+
+	unsigned edge_count() const { return _edge_count; }
+
+	/**
+	 * Return whether a point is inside the polygon, false if the polygon is empty.
+	 */
+	bool inside(double lat, double lon) const;
+
+	/**
+	 * Return the distance of a point to the closest edge in meters, NAN if the polygon is empty.
+	 */
+	float distance(double lat, double lon) const;
+
+	/**
+	 * Map a point into the local frame of the polygon.
+	 */
+	void project(double lat, double lon, float &north, float &east) const;
+
+private:
+	struct Edge {
+		float east_min;		/**< east coordinate of the western end */
+		float east_max;		/**< east coordinate of the eastern end */
+		float north_at_min;	/**< north coordinate of the western end */
+		float slope;		/**< dnorth/deast */
+	};
+
+	double _ref_lat;		/**< reference of the local frame in degrees */
+	double _ref_lon;
+	float _north_scale;		/**< meters per degree latitude */
+	float _east_scale;		/**< meters per degree longitude at the reference */
+
+	/* bounding box in the local frame */
+	float _north_min;
+	float _north_max;
+	float _east_min;
+	float _east_max;
+
+	struct Vertex {
+		float north;
+		float east;
+	};
+
+	Vertex *_vertices;
+	unsigned _vertex_count;
+
+	Edge *_edges;
+	unsigned _edge_count;
+
+	/* edges crossing band i are _band_edges[_band_start[i]] to _band_edges[_band_start[i + 1] - 1] */
+	uint32_t *_band_start;
+	uint16_t *_band_edges;
+	unsigned _band_count;
+	float _band_scale;		/**< bands per meter east */
+
+	unsigned band(float east) const;
+
+	/* do not allow copying this class */
+	GeofencePolygon(const GeofencePolygon &);
+	GeofencePolygon &operator=(const GeofencePolygon &);
+};
+
+#endif /* GEOFENCE_POLYGON_H_ */
@@ -0,0 +1,455 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file geofence_zones.cpp
+ * Geofence made of several inclusion and exclusion zones.
+ */
+
+#include "geofence_zones.h"
+
+#include <math.h>
+#include <px4_defines.h>
+#include <geo/geo.h>
+#include <mathlib/mathlib.h>
+
+/* Limit for the number of grid cells along each axis */
+static constexpr unsigned MAX_GRID_CELLS = 16;
+
+GeofenceZones::GeofenceZones() :
+	_ref_lat(0.0),
+	_ref_lon(0.0),
+	_north_scale(0.0f),
+	_east_scale(0.0f),
+	_zones(nullptr),
+	_zone_count(0),
+	_has_inclusion(false),
+	_polygons(nullptr),
+	_north_min(0.0f),
+	_east_min(0.0f),
+	_north_scale_grid(0.0f),
+	_east_scale_grid(0.0f),
+	_rows(0),
+	_cols(0),
+	_cell_start(nullptr),
+	_cell_zones(nullptr)
+{
+}
+
+GeofenceZones::~GeofenceZones()
+{
+	clear();
+}
+
+void
+GeofenceZones::clear()
+{
+	delete[] _zones;
+	delete[] _polygons;
+	delete[] _cell_start;
+	delete[] _cell_zones;
+
+	_zones = nullptr;
+	_polygons = nullptr;
+	_cell_start = nullptr;
+	_cell_zones = nullptr;
+	_zone_count = 0;
+	_has_inclusion = false;
+	_rows = 0;
+	_cols = 0;
+}
+
+void
+GeofenceZones::project(double lat, double lon, float &north, float &east) const
+{
+	north = (float)(lat - _ref_lat) * _north_scale;
+	east = (float)(lon - _ref_lon) * _east_scale;
+}
+
+unsigned
+GeofenceZones::row(float north) const
+{
+	int k = (int)((north - _north_min) * _north_scale_grid);
+
+	if (k < 0) {
+		return 0;
+	}
+
+	if (k >= (int)_rows) {
+		return _rows - 1;
+	}
+
+	return k;
+}
+
+unsigned
+GeofenceZones::col(float east) const
+{
+	int k = (int)((east - _east_min) * _east_scale_grid);
+
+	if (k < 0) {
+		return 0;
+	}
+
+	if (k >= (int)_cols) {
+		return _cols - 1;
+	}
+
+	return k;
+}
+
+bool
+GeofenceZones::build(const struct fence_vertex_s *vertices, unsigned count)
+{
+	clear();
+
+	if (vertices == nullptr || count == 0) {
+		return false;
+	}
+
+	/* first pass to validate the zones and count them */
+	unsigned zone_count = 0;
+	unsigned polygon_count = 0;
+
+	for (unsigned i = 0; i < count; zone_count++) {
+		switch (vertices[i].zone_type) {
+		case fence_vertex_s::ZONE_POLYGON_INCLUSION:
+		case fence_vertex_s::ZONE_POLYGON_EXCLUSION: {
+				const unsigned n = (vertices[i].vertex_count > 0) ? vertices[i].vertex_count : count - i;
+
+				if (n < 3 || n > count - i) {
+					return false;
+				}
+
+				polygon_count++;
+				i += n;
+				break;
+			}
+
+		case fence_vertex_s::ZONE_CIRCLE_INCLUSION:
+		case fence_vertex_s::ZONE_CIRCLE_EXCLUSION:
+			if (!PX4_ISFINITE(vertices[i].radius) || vertices[i].radius <= 0.0f) {
+				return false;
+			}
+
+			i++;
+			break;
+
+		default:
+			return false;
+		}
+	}
+
+	if (zone_count > MAX_ZONES) {
+		return false;
+	}
+
+	_ref_lat = vertices[0].lat;
+	_ref_lon = vertices[0].lon;
+	_north_scale = (float)(M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH);
+	_east_scale = (float)(M_DEG_TO_RAD * CONSTANTS_RADIUS_OF_EARTH * cos(_ref_lat * M_DEG_TO_RAD));
+
+	_zones = new Zone[zone_count];
+	_polygons = new GeofencePolygon[polygon_count];
+
+	if (_zones == nullptr || (polygon_count > 0 && _polygons == nullptr)) {
+		clear();
+		return false;
+	}
+
+	float north_min = INFINITY;
+	float north_max = -INFINITY;
+	float east_min = INFINITY;
+	float east_max = -INFINITY;
+
+	polygon_count = 0;
+
+	for (unsigned i = 0; i < count; _zone_count++) {
+		Zone &zone = _zones[_zone_count];
+		const uint8_t type = vertices[i].zone_type;
+
+		zone.exclusion = (type == fence_vertex_s::ZONE_POLYGON_EXCLUSION || type == fence_vertex_s::ZONE_CIRCLE_EXCLUSION);
+		_has_inclusion |= !zone.exclusion;
+
+		if (type == fence_vertex_s::ZONE_POLYGON_INCLUSION || type == fence_vertex_s::ZONE_POLYGON_EXCLUSION) {
+			const unsigned n = (vertices[i].vertex_count > 0) ? vertices[i].vertex_count : count - i;
+
+			zone.polygon = &_polygons[polygon_count++];
+
+			if (!zone.polygon->build(&vertices[i], n)) {
+				clear();
+				return false;
+			}
+
+			zone.north = zone.east = zone.radius = 0.0f;
+			zone.north_min = zone.east_min = INFINITY;
+			zone.north_max = zone.east_max = -INFINITY;
+
+			for (unsigned j = i; j < i + n; j++) {
+				float north, east;
+				project(vertices[j].lat, vertices[j].lon, north, east);
+
+				zone.north_min = fminf(zone.north_min, north);
+				zone.north_max = fmaxf(zone.north_max, north);
+				zone.east_min = fminf(zone.east_min, east);
+				zone.east_max = fmaxf(zone.east_max, east);
+			}
+
+			i += n;
+
+		} else {
+			zone.polygon = nullptr;
+			project(vertices[i].lat, vertices[i].lon, zone.north, zone.east);
+			zone.radius = vertices[i].radius;
+
+			if (!PX4_ISFINITE(zone.north) || !PX4_ISFINITE(zone.east)) {
+				clear();
+				return false;
+			}
+
+			zone.north_min = zone.north - zone.radius;
+			zone.north_max = zone.north + zone.radius;
+			zone.east_min = zone.east - zone.radius;
+			zone.east_max = zone.east + zone.radius;
+
+			i++;
+		}
+
+		north_min = fminf(north_min, zone.north_min);
+		north_max = fmaxf(north_max, zone.north_max);
+		east_min = fminf(east_min, zone.east_min);
+		east_max = fmaxf(east_max, zone.east_max);
+	}
+
+	/* square grid, roughly one cell per zone along each axis */
+	_rows = _cols = (_zone_count < MAX_GRID_CELLS) ? _zone_count : MAX_GRID_CELLS;
+	_north_min = north_min;
+	_east_min = east_min;
+	_north_scale_grid = _rows / fmaxf(north_max - north_min, 1.0f);
+	_east_scale_grid = _cols / fmaxf(east_max - east_min, 1.0f);
+
+	const unsigned cells = _rows * _cols;
+	_cell_start = new uint32_t[cells + 1];
+
+	if (_cell_start == nullptr) {
+		clear();
+		return false;
+	}
+
+	/* count the zones per cell, then fill the cells using the start of the following cell as cursor */
+	for (unsigned k = 0; k <= cells; k++) {
+		_cell_start[k] = 0;
+	}
+
+	for (unsigned z = 0; z < _zone_count; z++) {
+		for (unsigned r = row(_zones[z].north_min); r <= row(_zones[z].north_max); r++) {
+			for (unsigned c = col(_zones[z].east_min); c <= col(_zones[z].east_max); c++) {
+				_cell_start[r * _cols + c + 1]++;
+			}
+		}
+	}
+
+	for (unsigned k = 0; k < cells; k++) {
+		_cell_start[k + 1] += _cell_start[k];
+	}
+
+	_cell_zones = new uint8_t[_cell_start[cells]];
+
+	if (_cell_zones == nullptr) {
+		clear();
+		return false;
+	}
+
+	for (unsigned z = 0; z < _zone_count; z++) {
+		for (unsigned r = row(_zones[z].north_min); r <= row(_zones[z].north_max); r++) {
+			for (unsigned c = col(_zones[z].east_min); c <= col(_zones[z].east_max); c++) {
+				_cell_zones[_cell_start[r * _cols + c]++] = z;
+			}
+		}
+	}
+
+	for (unsigned k = cells; k > 0; k--) {
+		_cell_start[k] = _cell_start[k - 1];
+	}
+
+	_cell_start[0] = 0;
+
+	return true;
+}
+
+bool
+GeofenceZones::zone_contains(const Zone &zone, double lat, double lon, float north, float east) const
+{
+	if (zone.polygon != nullptr) {
+		return zone.polygon->inside(lat, lon);
+	}
+
+	const float d_north = north - zone.north;
+	const float d_east = east - zone.east;
+
+	return d_north * d_north + d_east * d_east <= zone.radius * zone.radius;
+}
+
+float
+GeofenceZones::zone_distance(const Zone &zone, double lat, double lon, float north, float east) const
+{
+	if (zone.polygon != nullptr) {
+		return zone.polygon->distance(lat, lon);
+	}
+
+	const float d_north = north - zone.north;
+	const float d_east = east - zone.east;
+
+	return fabsf(sqrtf(d_north * d_north + d_east * d_east) - zone.radius);
+}
+
+bool
+GeofenceZones::inside(double lat, double lon) const
+{
+	if (_zone_count == 0) {
+		return false;
+	}
+
+	float north, east;
+	project(lat, lon, north, east);
+
+	if (!PX4_ISFINITE(north) || !PX4_ISFINITE(east)) {
+		return false;
+	}
+
+	bool included = false;
+
+	/* positions outside of the grid are clamped to a border cell, the zones there are checked exactly */
+	const unsigned cell = row(north) * _cols + col(east);
+
+	for (uint32_t n = _cell_start[cell]; n < _cell_start[cell + 1]; n++) {
+		const Zone &zone = _zones[_cell_zones[n]];
+
+		if (north < zone.north_min || north > zone.north_max || east < zone.east_min || east > zone.east_max) {
+			continue;
+		}
+
+		if (zone_contains(zone, lat, lon, north, east)) {
+			if (zone.exclusion) {
+				return false;
+			}
+
+			included = true;
+		}
+	}
+
+	return included || !_has_inclusion;
+}
+
+float
+GeofenceZones::boundary_distance(double lat, double lon) const
+{
+	if (_zone_count == 0) {
+		return NAN;
+	}
+
+	float north, east;
+	project(lat, lon, north, east);
+
+	if (!PX4_ISFINITE(north) || !PX4_ISFINITE(east)) {
+		return NAN;
+	}
+
+	const int row0 = row(north);
+	const int col0 = col(east);
+	const int rings = math::max(math::max(row0, (int)_rows - 1 - row0), math::max(col0, (int)_cols - 1 - col0));
+
+	static_assert(MAX_ZONES <= 64, "visited zones do not fit the mask");
+	uint64_t visited = 0;
+	float min_dist = INFINITY;
+
+	/*
+	 * Visit the cells in square rings around the cell of the position, until
+	 * the closest boundary found is closer than any cell not visited yet.
+	 */
+	for (int k = 0; k <= rings; k++) {
+		if (k > 0) {
+			float bound = INFINITY;
+
+			if (row0 - k >= 0) {
+				bound = fminf(bound, north - (_north_min + (row0 - k + 1) / _north_scale_grid));
+			}
+
+			if (row0 + k < (int)_rows) {
+				bound = fminf(bound, _north_min + (row0 + k) / _north_scale_grid - north);
+			}
+
+			if (col0 - k >= 0) {
+				bound = fminf(bound, east - (_east_min + (col0 - k + 1) / _east_scale_grid));
+			}
+
+			if (col0 + k < (int)_cols) {
+				bound = fminf(bound, _east_min + (col0 + k) / _east_scale_grid - east);
+			}
+
+			if (min_dist <= bound) {
+				break;
+			}
+		}
+
+		for (int r = row0 - k; r <= row0 + k; r++) {
+			if (r < 0 || r >= (int)_rows) {
+				continue;
+			}
+
+			/* inner rows of the ring only have the two cells at its sides */
+			const int step = (r == row0 - k || r == row0 + k) ? 1 : math::max(2 * k, 1);
+
+			for (int c = col0 - k; c <= col0 + k; c += step) {
+				if (c < 0 || c >= (int)_cols) {
+					continue;
+				}
+
+				const unsigned cell = r * _cols + c;
+
+				for (uint32_t n = _cell_start[cell]; n < _cell_start[cell + 1]; n++) {
+					const unsigned z = _cell_zones[n];
+
+					if (visited & ((uint64_t)1 << z)) {
+						continue;
+					}
+
+					visited |= (uint64_t)1 << z;
+					min_dist = fminf(min_dist, zone_distance(_zones[z], lat, lon, north, east));
+				}
+			}
+		}
+	}
+
+	return min_dist;
+}
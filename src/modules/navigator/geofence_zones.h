@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file geofence_zones.h
+ * Geofence made of several inclusion and exclusion zones.
+ */
+
+#ifndef GEOFENCE_ZONES_H_
+#define GEOFENCE_ZONES_H_
+
+#include <stdint.h>
+#include <uORB/topics/fence_vertex.h>
+
+#include "geofence_polygon.h"
+
+/**
+ * Set of polygons and circles, each either an inclusion or an exclusion zone.
+ *
+ * A position is inside the fence if it is inside at least one inclusion zone,
+ * or there are no inclusion zones, and not inside any exclusion zone.
+ *
+ * The zones are indexed by a grid over their bounding boxes in a local frame
+ * around the first vertex. Every cell lists the zones whose bounding box
+ * overlaps it, so an inside check only looks at the zones of one cell and a
+ * distance query visits cells in rings around the position until no closer
+ * zone can follow.
+ */
+class GeofenceZones
+{
+public:
+	/** Limit for the number of zones */
+	static constexpr unsigned MAX_ZONES = 64;
+
+	GeofenceZones();
+	~GeofenceZones();
+
+	/**
+	 * Replace the zones by the ones described by fence vertices.
+	 *
+	 * A polygon zone consists of vertex_count consecutive vertices of the same
+	 * zone type, vertex_count is taken from the first one. A circle zone is a
+	 * single vertex holding the center and the radius.
+	 *
+	 * @param vertices	Fence vertices.
+	 * @param count		Number of vertices.
+	 * @return		false if a zone is invalid or the tables cannot be allocated,
+	 *			there are no zones then.
+	 */
+	bool build(const struct fence_vertex_s *vertices, unsigned count);
+
+	void clear();
+
+	bool empty() const { return _zone_count == 0; }
+
+	unsigned zone_count() const { return _zone_count; }
+
+	/**
+	 * Return whether a position is allowed by the zones, false if there are no zones.
+	 */
+	bool inside(double lat, double lon) const;
+
+	/**
+	 * Return the distance of a position to the closest zone boundary in meters,
+	 * NAN if there are no zones.
+	 */
+	float boundary_distance(double lat, double lon) const;
+
+private:
+	struct Zone {
+		bool exclusion;
+		GeofencePolygon *polygon;	/**< nullptr for a circle */
+		float north;			/**< circle center in the local frame */
+		float east;
+		float radius;
+		float north_min;		/**< bounding box in the local frame */
+		float north_max;
+		float east_min;
+		float east_max;
+	};
+
+	double _ref_lat;		/**< reference of the local frame in degrees */
+	double _ref_lon;
+	float _north_scale;		/**< meters per degree latitude */
+	float _east_scale;		/**< meters per degree longitude at the reference */
+
+	Zone *_zones;
+	unsigned _zone_count;
+	bool _has_inclusion;
+
+	GeofencePolygon *_polygons;
+
+	/* grid over the bounding box of all zones */
+	float _north_min;
+	float _east_min;
+	float _north_scale_grid;	/**< cells per meter north */
+	float _east_scale_grid;		/**< cells per meter east */
+	unsigned _rows;
+	unsigned _cols;
+
+	/* zones overlapping cell i are _cell_zones[_cell_start[i]] to _cell_zones[_cell_start[i + 1] - 1] */
+	uint32_t *_cell_start;
+	uint8_t *_cell_zones;
+
+	void project(double lat, double lon, float &north, float &east) const;
+
+	unsigned row(float north) const;
+	unsigned col(float east) const;
+
+	bool zone_contains(const Zone &zone, double lat, double lon, float north, float east) const;
+	float zone_distance(const Zone &zone, double lat, double lon, float north, float east) const;
+
+	/* do not allow copying this class */
+	GeofenceZones(const GeofenceZones &);
+	GeofenceZones &operator=(const GeofenceZones &);
+};
+
+#endif /* GEOFENCE_ZONES_H_ */
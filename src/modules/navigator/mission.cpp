@@ -71,6 +71,7 @@ Mission::Mission(Navigator *navigator, const char *name) :
 	_param_onboard_enabled(this, "MIS_ONBOARD_EN", false),
 	_param_takeoff_alt(this, "MIS_TAKEOFF_ALT", false),
 	_param_dist_1wp(this, "MIS_DIST_1WP", false),
+	_param_terrain_clearance(this, "MIS_TERR_CLR", false),
 	_param_altmode(this, "MIS_ALTMODE", false),
 	_param_yawmode(this, "MIS_YAWMODE", false),
 	_param_force_vtol(this, "VT_NAV_FORCE_VT", false),
@@ -84,6 +85,7 @@ Mission::Mission(Navigator *navigator, const char *name) :
 	_home_inited(false),
 	_need_mission_reset(false),
 	_missionFeasibilityChecker(),
+	_item_cache(),
 	_min_current_sp_distance_xy(FLT_MAX),
 	_mission_item_previous_alt(NAN),
 	_distance_current_previous(0.0f),
@@ -217,6 +219,8 @@ Mission::on_active()
 void
 Mission::update_onboard_mission()
 {
+	_item_cache.invalidate();
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >=0
@@ -252,6 +256,8 @@ Mission::update_offboard_mission()
 {
 	bool failed = true;
 
+	_item_cache.invalidate();
+
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		warnx("offboard mission updated: dataman_id=%d, count=%d, current_seq=%d", _offboard_mission.dataman_id, _offboard_mission.count, _offboard_mission.current_seq);
 		/* determine current index */
@@ -278,7 +284,7 @@ Mission::update_offboard_mission()
 				_navigator->get_home_position()->alt, _navigator->home_position_valid(),
 				_navigator->get_global_position()->lat, _navigator->get_global_position()->lon,
 				_param_dist_1wp.get(), _navigator->get_mission_result()->warning, _navigator->get_default_acceptance_radius(),
-				_navigator->get_land_detected()->landed);
+				_navigator->get_land_detected()->landed, _param_terrain_clearance.get());
 
 		_navigator->get_mission_result()->valid = !failed;
 		if (!failed) {
@@ -968,13 +974,11 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 			return false;
 		}
 
-		const ssize_t len = sizeof(struct mission_item_s);
-
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the read ahead cache */
+		if (!_item_cache.read(dm_item, mission->count, *mission_index_ptr, &mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_and_console_log_critical(_navigator->get_mavlink_log_pub(), "ERROR waypoint could not be read");
 			return false;
@@ -991,8 +995,7 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 				if (offset == 0) {
 					(mission_item_tmp.do_jump_current_count)++;
 					/* save repeat count */
-					if (dm_write(dm_item, *mission_index_ptr, DM_PERSIST_POWER_ON_RESET,
-						&mission_item_tmp, len) != len) {
+					if (!_item_cache.write(dm_item, *mission_index_ptr, &mission_item_tmp)) {
 						/* not supposed to happen unless the datamanager can't access the
 						 * dataman */
 						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR DO JUMP waypoint could not be written");
@@ -1118,7 +1121,7 @@ Mission::check_mission_valid()
 				_navigator->get_home_position()->alt, _navigator->home_position_valid(),
 				_navigator->get_global_position()->lat, _navigator->get_global_position()->lon,
 				_param_dist_1wp.get(), _navigator->get_mission_result()->warning, _navigator->get_default_acceptance_radius(),
-				_navigator->get_land_detected()->landed);
+				_navigator->get_land_detected()->landed, _param_terrain_clearance.get());
 
 		_navigator->increment_mission_instance_count();
 		_navigator->set_mission_result_updated();
@@ -1177,6 +1180,9 @@ Mission::reset_offboard_mission(struct mission_s &mission)
 	}
 
 	dm_unlock(DM_KEY_MISSION_STATE);
+
+	/* the jump counters were reset behind the back of the cache */
+	_item_cache.invalidate();
 }
 
 bool
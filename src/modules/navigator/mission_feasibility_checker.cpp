@@ -51,25 +51,45 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <string.h>
 #include <uORB/topics/fence.h>
 
 MissionFeasibilityChecker::MissionFeasibilityChecker() :
 	_mavlink_log_pub(nullptr),
 	_capabilities_sub(-1),
 	_initDone(false),
-	_dist_1wp_ok(false)
+	_dist_1wp_ok(false),
+	_item_cache(),
+	_items_total(0),
+	_verdicts{},
+	_verdicts_dm(DM_KEY_NUM_KEYS),
+	_verdicts_count(0),
+	_fence_verdicts_valid(false),
+	_fence_version(0),
+	_home_verdicts_valid(false),
+	_home_alt(0.0f),
+	_acceptance_rad(0.0f),
+	_landing_verdicts_valid(false),
+	_landing_caps{},
+	_first_position_lat(0.0),
+	_first_position_lon(0.0),
+	_terrain()
 {
 	_nav_caps = {0};
 }
 
+bool MissionFeasibilityChecker::readMissionItem(dm_item_t dm_current, size_t index, struct mission_item_s &item)
+{
+	return _item_cache.read(dm_current, _items_total, index, &item);
+}
+
 
 bool MissionFeasibilityChecker::checkMissionFeasible(orb_advert_t *mavlink_log_pub, bool isRotarywing,
 	dm_item_t dm_current, size_t nMissionItems, Geofence &geofence,
 	float home_alt, bool home_valid, double curr_lat, double curr_lon, float max_waypoint_distance, bool &warning_issued,
 	float default_acceptance_rad,
-	bool condition_landed)
+	bool condition_landed, float min_terrain_clearance)
 {
-	bool failed = false;
 	bool warned = false;
 	/* Init if not done yet */
 	init();
@@ -78,264 +98,413 @@ bool MissionFeasibilityChecker::checkMissionFeasible(orb_advert_t *mavlink_log_p
 
 	// first check if we have a valid position
 	if (!home_valid /* can later use global / local pos for finer granularity */) {
-		failed = true;
-		warned = true;
 		mavlink_log_info(_mavlink_log_pub, "Not yet ready for mission, no position lock.");
-	} else {
-		failed = failed || !check_dist_1wp(dm_current, nMissionItems, curr_lat, curr_lon, max_waypoint_distance, warning_issued);
+		return false;
 	}
 
-	// check if all mission item commands are supported
-	failed = failed || !checkMissionItemValidity(dm_current, nMissionItems, condition_landed);
-	failed = failed || !checkGeofence(dm_current, nMissionItems, geofence);
-	failed = failed || !checkHomePositionAltitude(dm_current, nMissionItems, home_alt, home_valid, warned);
+	if (!isRotarywing) {
+		/* Update fixed wing navigation capabilites */
+		updateNavigationCapabilities();
+	}
+
+	/* one pass over the items, only for the verdicts whose inputs changed */
+	if (!updateVerdicts(dm_current, nMissionItems, geofence, home_alt, default_acceptance_rad, !isRotarywing)) {
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
+		return false;
+	}
+
+	/* evaluate the rules in their order, each stops at its first failing item */
+	if (!check_dist_1wp(dm_current, nMissionItems, curr_lat, curr_lon, max_waypoint_distance, warning_issued) ||
+	    !checkMissionItemValidity(dm_current, nMissionItems, condition_landed) ||
+	    !checkGeofence(nMissionItems) ||
+	    !checkHomePositionAltitude(nMissionItems, warned) ||
+	    !checkTerrainClearance(dm_current, nMissionItems, home_alt, min_terrain_clearance)) {
+		return false;
+	}
 
 	if (isRotarywing) {
-		failed = failed || !checkMissionFeasibleRotarywing(dm_current, nMissionItems, geofence, home_alt, home_valid, default_acceptance_rad);
+		return checkMissionFeasibleRotarywing(nMissionItems);
 	} else {
-		failed = failed || !checkMissionFeasibleFixedwing(dm_current, nMissionItems, geofence, home_alt, home_valid);
+		return checkMissionFeasibleFixedwing(dm_current, nMissionItems);
 	}
-
-	return !failed;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems,
-	Geofence &geofence, float home_alt, bool home_valid, float default_acceptance_rad)
+bool MissionFeasibilityChecker::updateVerdicts(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence,
+	float home_alt, float default_acceptance_rad, bool isFixedwing)
 {
-	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
+	if (nMissionItems > NUM_MISSIONS_SUPPORTED) {
+		return false;
+	}
+
+	/* the items only change with the dataman id, uploads always go to the inactive one */
+	const bool items_stale = (dm_current != _verdicts_dm || nMissionItems != _verdicts_count);
+	const bool fence_stale = items_stale || !_fence_verdicts_valid || geofence.getVersion() != _fence_version;
+	const bool home_stale = items_stale || !_home_verdicts_valid || home_alt != _home_alt ||
+				default_acceptance_rad != _acceptance_rad;
+	const bool landing_stale = isFixedwing && (items_stale || !_landing_verdicts_valid ||
+				   memcmp(&_landing_caps, &_nav_caps, sizeof(_nav_caps)) != 0);
+
+	if (!fence_stale && !home_stale && !landing_stale) {
+		return true;
+	}
+
+	uint8_t stale = 0;
+	/* landing verdicts of other items must not survive, even if they are not recomputed for this vehicle */
+	stale |= items_stale ? (ITEM_UNSUPPORTED | ITEM_POSITION | ITEM_LAND | ITEM_SERVO_INVALID | ITEM_LAND_INFEASIBLE) : 0;
+	stale |= fence_stale ? ITEM_OUTSIDE_FENCE : 0;
+	stale |= home_stale ? (ITEM_BELOW_HOME | ITEM_TAKEOFF_LOW) : 0;
+	stale |= landing_stale ? ITEM_LAND_INFEASIBLE : 0;
+
+	_item_cache.invalidate();
+	_items_total = nMissionItems;
+
+	/* the verdicts are incomplete until the pass is done */
+	_verdicts_dm = DM_KEY_NUM_KEYS;
+
+	bool first_position = true;
+	struct mission_item_s missionitem_previous = {};
+
 	for (size_t i = 0; i < nMissionItems; i++) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (!readMissionItem(dm_current, i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			return false;
 		}
 
-		// look for a takeoff waypoint
-		if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
-			// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
-			// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
-			float takeoff_alt = missionitem.altitude_is_relative
-				      ? missionitem.altitude
-			              : missionitem.altitude - home_alt;
-			// check if we should use default acceptance radius
-			float acceptance_radius = default_acceptance_rad;
-
-			if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
-				acceptance_radius = missionitem.acceptance_radius;
+		uint8_t verdict = _verdicts[i] & ~stale;
+
+		if (items_stale) {
+			if (!isSupportedCommand(missionitem.nav_cmd)) {
+				verdict |= ITEM_UNSUPPORTED;
 			}
 
-			if (takeoff_alt - 1.0f < acceptance_radius) {
-				mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff altitude too low!");
-				return false;
+			if (isPositionCommand(missionitem.nav_cmd)) {
+				verdict |= ITEM_POSITION;
+
+				if (first_position) {
+					_first_position_lat = missionitem.lat;
+					_first_position_lon = missionitem.lon;
+					first_position = false;
+				}
+			}
+
+			if (missionitem.nav_cmd == NAV_CMD_LAND) {
+				verdict |= ITEM_LAND;
+			}
+
+			if (missionitem.nav_cmd == NAV_CMD_DO_SET_SERVO &&
+			    (missionitem.params[0] < 0 || missionitem.params[0] > 5 ||
+			     missionitem.params[1] < -2000 || missionitem.params[1] > 2000)) {
+				verdict |= ITEM_SERVO_INVALID;
 			}
 		}
+
+		if (fence_stale && MissionBlock::item_contains_position(&missionitem) &&
+		    !geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+			verdict |= ITEM_OUTSIDE_FENCE;
+		}
+
+		if (home_stale) {
+			/* calculate the global waypoint altitude */
+			float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+
+			if (home_alt > wp_alt && isPositionCommand(missionitem.nav_cmd)) {
+				verdict |= ITEM_BELOW_HOME;
+			}
+
+			if (missionitem.nav_cmd == NAV_CMD_TAKEOFF && !checkTakeoffAltitude(missionitem, home_alt, default_acceptance_rad)) {
+				verdict |= ITEM_TAKEOFF_LOW;
+			}
+		}
+
+		if (landing_stale && missionitem.nav_cmd == NAV_CMD_LAND &&
+		    (i == 0 || !checkFixedWingLanding(missionitem_previous, missionitem, false))) {
+			verdict |= ITEM_LAND_INFEASIBLE;
+		}
+
+		_verdicts[i] = verdict;
+		missionitem_previous = missionitem;
+	}
+
+	_verdicts_dm = dm_current;
+	_verdicts_count = nMissionItems;
+
+	if (fence_stale) {
+		_fence_verdicts_valid = true;
+		_fence_version = geofence.getVersion();
+	}
+
+	if (home_stale) {
+		_home_verdicts_valid = true;
+		_home_alt = home_alt;
+		_acceptance_rad = default_acceptance_rad;
+	}
+
+	if (landing_stale) {
+		_landing_verdicts_valid = true;
+		_landing_caps = _nav_caps;
+
+	} else if (items_stale) {
+		_landing_verdicts_valid = false;
 	}
 
-	// all checks have passed
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid)
+int MissionFeasibilityChecker::firstItem(size_t nMissionItems, uint8_t verdict)
 {
-	/* Update fixed wing navigation capabilites */
-	updateNavigationCapabilities();
-
-	/* Perform checks and issue feedback to the user for all checks */
-	bool resLanding = checkFixedWingLanding(dm_current, nMissionItems);
+	for (size_t i = 0; i < nMissionItems; i++) {
+		if (_verdicts[i] & verdict) {
+			return i;
+		}
+	}
 
-	/* Mission is only marked as feasible if all checks return true */
-	return resLanding;
+	return -1;
 }
 
-bool MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence)
+bool MissionFeasibilityChecker::checkTakeoffAltitude(const struct mission_item_s &missionitem, float home_alt,
+	float default_acceptance_rad)
 {
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (geofence.valid()) {
-		for (size_t i = 0; i < nMissionItems; i++) {
-			struct mission_item_s missionitem;
-			const ssize_t len = sizeof(missionitem);
-
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+	// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
+	// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
+	float takeoff_alt = missionitem.altitude_is_relative
+			    ? missionitem.altitude
+			    : missionitem.altitude - home_alt;
+	// check if we should use default acceptance radius
+	float acceptance_radius = default_acceptance_rad;
+
+	if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
+		acceptance_radius = missionitem.acceptance_radius;
+	}
 
-			if (MissionBlock::item_contains_position(&missionitem) &&
-				!geofence.inside_polygon(missionitem.lat, missionitem.lon, missionitem.altitude)) {
+	return takeoff_alt - 1.0f >= acceptance_radius;
+}
 
-				mavlink_log_critical(_mavlink_log_pub, "Geofence violation for waypoint %d", i);
-				return false;
-			}
-		}
+bool MissionFeasibilityChecker::checkMissionFeasibleRotarywing(size_t nMissionItems)
+{
+	// look for a takeoff waypoint that is too low
+	if (firstItem(nMissionItems, ITEM_TAKEOFF_LOW) >= 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff altitude too low!");
+		return false;
 	}
 
+	// all checks have passed
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems,
-	float home_alt, bool home_valid, bool &warning_issued, bool throw_error)
+bool MissionFeasibilityChecker::checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems)
 {
-	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
+	/* the first landing waypoint decides */
+	int land = firstItem(nMissionItems, ITEM_LAND);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			warning_issued = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	if (land < 0 || !(_verdicts[land] & ITEM_LAND_INFEASIBLE)) {
+		/* No landing waypoints or no waypoints */
+		return true;
+	}
 
-		/* reject relative alt without home set */
-		if (missionitem.altitude_is_relative && !home_valid && isPositionCommand(missionitem.nav_cmd)) {
+	if (land == 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Warning: starting with land waypoint");
+		return false;
+	}
 
-			warning_issued = true;
+	/* read the waypoints again to report the details */
+	struct mission_item_s missionitem;
+	struct mission_item_s missionitem_previous;
 
-			if (throw_error) {
-				mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: No home pos, WP %d uses rel alt", i+1);
-				return false;
-			} else	{
-				mavlink_log_critical(_mavlink_log_pub, "Warning: No home pos, WP %d uses rel alt", i+1);
-				return true;
-			}
-		}
+	if (!readMissionItem(dm_current, land - 1, missionitem_previous) ||
+	    !readMissionItem(dm_current, land, missionitem)) {
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		return false;
+	}
+
+	return checkFixedWingLanding(missionitem_previous, missionitem, true);
+}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+bool MissionFeasibilityChecker::checkGeofence(size_t nMissionItems)
+{
+	/* Check if all mission items are inside the geofence, none is if it could not be loaded */
+	int i = firstItem(nMissionItems, ITEM_OUTSIDE_FENCE);
 
-		if (home_alt > wp_alt && isPositionCommand(missionitem.nav_cmd)) {
+	if (i >= 0) {
+		mavlink_log_critical(_mavlink_log_pub, "Geofence violation for waypoint %d", i);
+		return false;
+	}
 
-			warning_issued = true;
+	return true;
+}
 
-			if (throw_error) {
-				mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: Waypoint %d below home", i+1);
-				return false;
-			} else	{
-				mavlink_log_critical(_mavlink_log_pub, "Warning: Waypoint %d below home", i+1);
-				return true;
-			}
+bool MissionFeasibilityChecker::checkHomePositionAltitude(size_t nMissionItems, bool &warning_issued, bool throw_error)
+{
+	/* Check if all all waypoints are above the home altitude, only return false if bool throw_error = true */
+	int i = firstItem(nMissionItems, ITEM_BELOW_HOME);
+
+	if (i >= 0) {
+
+		warning_issued = true;
+
+		if (throw_error) {
+			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: Waypoint %d below home", i+1);
+			return false;
+		} else	{
+			mavlink_log_critical(_mavlink_log_pub, "Warning: Waypoint %d below home", i+1);
+			return true;
 		}
 	}
 
 	return true;
 }
 
-bool MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed) {
-	// do not allow mission if we find unsupported item
-	for (size_t i = 0; i < nMissionItems; i++) {
+bool MissionFeasibilityChecker::checkTerrainClearance(dm_item_t dm_current, size_t nMissionItems, float home_alt,
+	float min_clearance)
+{
+	if (min_clearance <= 0.0f) {
+		return true;
+	}
+
+	/* check the legs between consecutive position items, except the final descent of a landing */
+	struct mission_item_s missionitem_previous;
+	bool have_previous = false;
+	bool unknown = false;
+	bool result = true;
+
+	for (size_t i = 0; i < nMissionItems && result; i++) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			// not supposed to happen unless the datamanager can't access the SD card, etc.
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
-			return false;
+		if (!(_verdicts[i] & ITEM_POSITION)) {
+			continue;
 		}
 
-		// check if we find unsupported items and reject mission if so
-		if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-			missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
-			missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
-			/* not yet supported: missionitem.nav_cmd != NAV_CMD_LOITER_TURN_COUNT && */
-			missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
-			missionitem.nav_cmd != NAV_CMD_LAND &&
-			missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
-			missionitem.nav_cmd != NAV_CMD_VTOL_LAND &&
-			missionitem.nav_cmd != NAV_CMD_VTOL_TAKEOFF &&
-			missionitem.nav_cmd != NAV_CMD_PATHPLANNING &&
-			missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-			missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
-			missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
-			missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
-			missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
-			missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
-
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission item %i: unsupported cmd: %d", (int)(i+1), (int)missionitem.nav_cmd);
-			return false;
+		if (!readMissionItem(dm_current, i, missionitem)) {
+			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+			mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
+			result = false;
+			break;
 		}
 
-		// check if the mission starts with a land command while the vehicle is landed
-		if (missionitem.nav_cmd == NAV_CMD_LAND &&
-			i == 0 &&
-			condition_landed) {
+		if (have_previous && missionitem.nav_cmd != NAV_CMD_LAND && missionitem.nav_cmd != NAV_CMD_VTOL_LAND) {
+			float alt_previous = missionitem_previous.altitude_is_relative ? missionitem_previous.altitude + home_alt :
+					     missionitem_previous.altitude;
+			float alt = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
+			float clearance;
 
-			mavlink_log_critical(_mavlink_log_pub, "Rejecting mission that starts with LAND command while vehicle is landed.");
-			return false;
+			if (!_terrain.min_clearance(missionitem_previous.lat, missionitem_previous.lon, alt_previous,
+						    missionitem.lat, missionitem.lon, alt, clearance)) {
+				unknown = true;
+
+			} else if (clearance < min_clearance) {
+				mavlink_log_critical(_mavlink_log_pub, "Rejecting mission: leg to waypoint %d only %dm above terrain",
+						     (int)(i + 1), (int)clearance);
+				result = false;
+			}
 		}
 
+		missionitem_previous = missionitem;
+		have_previous = true;
+	}
 
+	if (result && unknown) {
+		mavlink_log_info(_mavlink_log_pub, "No terrain data for parts of the mission, not checked");
 	}
-	return true;
+
+	/* the tiles are not needed until the next check */
+	_terrain.close();
+
+	return result;
 }
 
-bool MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems)
+bool MissionFeasibilityChecker::isSupportedCommand(unsigned cmd)
 {
-	/* Go through all mission items and search for a landing waypoint
-	 * if landing waypoint is found: the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
+	return (cmd == NAV_CMD_IDLE ||
+		cmd == NAV_CMD_WAYPOINT ||
+		cmd == NAV_CMD_LOITER_UNLIMITED ||
+		/* not yet supported: cmd == NAV_CMD_LOITER_TURN_COUNT || */
+		cmd == NAV_CMD_LOITER_TIME_LIMIT ||
+		cmd == NAV_CMD_LAND ||
+		cmd == NAV_CMD_TAKEOFF ||
+		cmd == NAV_CMD_VTOL_LAND ||
+		cmd == NAV_CMD_VTOL_TAKEOFF ||
+		cmd == NAV_CMD_PATHPLANNING ||
+		cmd == NAV_CMD_DO_JUMP ||
+		cmd == NAV_CMD_DO_SET_SERVO ||
+		cmd == NAV_CMD_DO_CHANGE_SPEED ||
+		cmd == NAV_CMD_DO_DIGICAM_CONTROL ||
+		cmd == NAV_CMD_DO_SET_CAM_TRIGG_DIST ||
+		cmd == NAV_CMD_DO_VTOL_TRANSITION);
+}
 
+bool MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed) {
+	// check if the mission starts with a land command while the vehicle is landed
+	if (nMissionItems > 0 && (_verdicts[0] & ITEM_LAND) && condition_landed) {
 
-	for (size_t i = 0; i < nMissionItems; i++) {
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting mission that starts with LAND command while vehicle is landed.");
+		return false;
+	}
+
+	// do not allow mission if we find unsupported item
+	int i = firstItem(nMissionItems, ITEM_UNSUPPORTED);
+
+	if (i >= 0) {
 		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+
+		if (!readMissionItem(dm_current, i, missionitem)) {
+			// not supposed to happen unless the datamanager can't access the SD card, etc.
+			mavlink_log_critical(_mavlink_log_pub, "Rejecting Mission: Cannot access SD card");
 			return false;
 		}
 
-		if (missionitem.nav_cmd == NAV_CMD_LAND) {
-			struct mission_item_s missionitem_previous;
-			if (i != 0) {
-				if (dm_read(dm_current, i-1, &missionitem_previous, len) != len) {
-					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-					return false;
-				}
+		mavlink_log_critical(_mavlink_log_pub, "Rejecting mission item %i: unsupported cmd: %d", (int)(i+1), (int)missionitem.nav_cmd);
+		return false;
+	}
 
-				float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
-				float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
-				float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
-//				warnx("wp_distance %.2f, delta_altitude %.2f, missionitem_previous.altitude %.2f, missionitem.altitude %.2f, slope_alt_req %.2f, wp_distance_req %.2f",
-//						wp_distance, delta_altitude, missionitem_previous.altitude, missionitem.altitude, slope_alt_req, wp_distance_req);
-//				warnx("_nav_caps.landing_horizontal_slope_displacement %.4f, _nav_caps.landing_slope_angle_rad %.4f, _nav_caps.landing_flare_length %.4f",
-//						_nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad, _nav_caps.landing_flare_length);
-
-				if (wp_distance > _nav_caps.landing_flare_length) {
-					/* Last wp is before flare region */
-
-					if (delta_altitude < 0) {
-						if (missionitem_previous.altitude <= slope_alt_req) {
-							/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
-							return true;
-						} else {
-							/* Landing waypoint is above altitude of slope at the given waypoint distance */
-							mavlink_log_critical(_mavlink_log_pub, "Landing: last waypoint too high/too close");
-							mavlink_log_critical(_mavlink_log_pub, "Move down to %.1fm or move further away by %.1fm",
-									(double)(slope_alt_req),
-									(double)(wp_distance_req - wp_distance));
-							return false;
-						}
-					} else {
-						/* Landing waypoint is above last waypoint */
-						mavlink_log_critical(_mavlink_log_pub, "Landing waypoint above last nav waypoint");
-						return false;
-					}
-				} else {
-					/* Last wp is in flare region */
-					//xxx give recommendations
-					mavlink_log_critical(_mavlink_log_pub, "Warning: Landing: last waypoint in flare region");
-					return false;
-				}
+	return true;
+}
+
+bool MissionFeasibilityChecker::checkFixedWingLanding(const struct mission_item_s &missionitem_previous,
+	const struct mission_item_s &missionitem, bool report)
+{
+	/* the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
+	float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat , missionitem_previous.lon, missionitem.lat, missionitem.lon);
+	float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+	float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude, _nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad);
+	float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
+//	warnx("wp_distance %.2f, delta_altitude %.2f, missionitem_previous.altitude %.2f, missionitem.altitude %.2f, slope_alt_req %.2f, wp_distance_req %.2f",
+//			wp_distance, delta_altitude, missionitem_previous.altitude, missionitem.altitude, slope_alt_req, wp_distance_req);
+//	warnx("_nav_caps.landing_horizontal_slope_displacement %.4f, _nav_caps.landing_slope_angle_rad %.4f, _nav_caps.landing_flare_length %.4f",
+//			_nav_caps.landing_horizontal_slope_displacement, _nav_caps.landing_slope_angle_rad, _nav_caps.landing_flare_length);
+
+	if (wp_distance > _nav_caps.landing_flare_length) {
+		/* Last wp is before flare region */
+
+		if (delta_altitude < 0) {
+			if (missionitem_previous.altitude <= slope_alt_req) {
+				/* Landing waypoint is at or below altitude of slope at the given waypoint distance: this is ok, aircraft will intersect the slope */
+				return true;
 			} else {
-				mavlink_log_critical(_mavlink_log_pub, "Warning: starting with land waypoint");
+				/* Landing waypoint is above altitude of slope at the given waypoint distance */
+				if (report) {
+					mavlink_log_critical(_mavlink_log_pub, "Landing: last waypoint too high/too close");
+					mavlink_log_critical(_mavlink_log_pub, "Move down to %.1fm or move further away by %.1fm",
+							(double)(slope_alt_req),
+							(double)(wp_distance_req - wp_distance));
+				}
 				return false;
 			}
+		} else {
+			/* Landing waypoint is above last waypoint */
+			if (report) {
+				mavlink_log_critical(_mavlink_log_pub, "Landing waypoint above last nav waypoint");
+			}
+			return false;
+		}
+	} else {
+		/* Last wp is in flare region */
+		//xxx give recommendations
+		if (report) {
+			mavlink_log_critical(_mavlink_log_pub, "Warning: Landing: last waypoint in flare region");
 		}
+		return false;
 	}
-
-	/* No landing waypoints or no waypoints */
-	return true;
 }
 
 bool
@@ -344,57 +513,53 @@ MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionI
 
 	/* check if first waypoint is not too far from home */
 	if (dist_first_wp > 0.0f) {
-		struct mission_item_s mission_item;
-
-		/* find first waypoint (with lat/lon) item in datamanager */
-		for (unsigned i = 0; i < nMissionItems; i++) {
-			if (dm_read(dm_current, i,
-					&mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s)) {
-				/* Check non navigation item */
-				if (mission_item.nav_cmd == NAV_CMD_DO_SET_SERVO){
-
-					/* check actuator number */
-					if (mission_item.params[0] < 0 || mission_item.params[0] > 5) {
-						mavlink_log_critical(_mavlink_log_pub, "Actuator number %d is out of bounds 0..5", (int)mission_item.params[0]);
-						warning_issued = true;
-						return false;
-					}
-					/* check actuator value */
-					if (mission_item.params[1] < -2000 || mission_item.params[1] > 2000) {
-						mavlink_log_critical(_mavlink_log_pub, "Actuator value %d is out of bounds -2000..2000", (int)mission_item.params[1]);
-						warning_issued = true;
-						return false;
-					}
-				}
-				/* check only items with valid lat/lon */
-				else if (isPositionCommand(mission_item.nav_cmd)) {
-
-					/* check distance from current position to item */
-					float dist_to_1wp = get_distance_to_next_waypoint(
-							mission_item.lat, mission_item.lon, curr_lat, curr_lon);
-
-					if (dist_to_1wp < dist_first_wp) {
-						_dist_1wp_ok = true;
-						if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
-							/* allow at 2/3 distance, but warn */
-							mavlink_log_critical(_mavlink_log_pub, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
-							warning_issued = true;
-						}
-						return true;
-
-					} else {
-						/* item is too far from home */
-						mavlink_log_critical(_mavlink_log_pub, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
-						warning_issued = true;
-						return false;
-					}
-				}
+		/* find first waypoint (with lat/lon) item, servo items before it are checked as well */
+		int first_wp = firstItem(nMissionItems, ITEM_POSITION);
+		int servo = firstItem(first_wp >= 0 ? first_wp : nMissionItems, ITEM_SERVO_INVALID);
 
-			} else {
+		if (servo >= 0) {
+			struct mission_item_s mission_item;
+
+			if (!readMissionItem(dm_current, servo, mission_item)) {
 				/* error reading, mission is invalid */
 				mavlink_log_info(_mavlink_log_pub, "error reading offboard mission");
 				return false;
 			}
+
+			/* check actuator number */
+			if (mission_item.params[0] < 0 || mission_item.params[0] > 5) {
+				mavlink_log_critical(_mavlink_log_pub, "Actuator number %d is out of bounds 0..5", (int)mission_item.params[0]);
+				warning_issued = true;
+				return false;
+			}
+			/* check actuator value */
+			if (mission_item.params[1] < -2000 || mission_item.params[1] > 2000) {
+				mavlink_log_critical(_mavlink_log_pub, "Actuator value %d is out of bounds -2000..2000", (int)mission_item.params[1]);
+				warning_issued = true;
+				return false;
+			}
+		}
+
+		if (first_wp >= 0) {
+			/* check distance from current position to item */
+			float dist_to_1wp = get_distance_to_next_waypoint(
+					_first_position_lat, _first_position_lon, curr_lat, curr_lon);
+
+			if (dist_to_1wp < dist_first_wp) {
+				_dist_1wp_ok = true;
+				if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
+					/* allow at 2/3 distance, but warn */
+					mavlink_log_critical(_mavlink_log_pub, "Warning: First waypoint very far: %d m", (int)dist_to_1wp);
+					warning_issued = true;
+				}
+				return true;
+
+			} else {
+				/* item is too far from home */
+				mavlink_log_critical(_mavlink_log_pub, "First waypoint too far: %d m,refusing mission", (int)dist_to_1wp, (int)dist_first_wp);
+				warning_issued = true;
+				return false;
+			}
 		}
 
 		/* no waypoints found in mission, then we will not fly far away */
@@ -47,6 +47,8 @@
 #include <uORB/topics/navigation_capabilities.h>
 #include <dataman/dataman.h>
 #include "geofence.h"
+#include "mission_item_cache.h"
+#include <terrain_estimation/terrain_database.h>
 
 
 class MissionFeasibilityChecker
@@ -61,20 +63,61 @@ private:
 	bool _dist_1wp_ok;
 	void init();
 
+	/* Mission items are fetched from the dataman in chunks */
+	MissionItemCache _item_cache;
+	size_t _items_total;
+	bool readMissionItem(dm_item_t dm_current, size_t index, struct mission_item_s &item);
+
+	/* Per item verdicts, each group is recomputed only when its inputs change */
+	enum {
+		ITEM_UNSUPPORTED = (1 << 0),
+		ITEM_POSITION = (1 << 1),
+		ITEM_LAND = (1 << 2),
+		ITEM_SERVO_INVALID = (1 << 3),
+		ITEM_OUTSIDE_FENCE = (1 << 4),
+		ITEM_BELOW_HOME = (1 << 5),
+		ITEM_TAKEOFF_LOW = (1 << 6),
+		ITEM_LAND_INFEASIBLE = (1 << 7)
+	};
+
+	uint8_t _verdicts[NUM_MISSIONS_SUPPORTED];
+	dm_item_t _verdicts_dm;
+	size_t _verdicts_count;
+	bool _fence_verdicts_valid;
+	unsigned _fence_version;
+	bool _home_verdicts_valid;
+	float _home_alt;
+	float _acceptance_rad;
+	bool _landing_verdicts_valid;
+	struct navigation_capabilities_s _landing_caps;
+	double _first_position_lat;
+	double _first_position_lon;
+
+	bool updateVerdicts(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence,
+		float home_alt, float default_acceptance_rad, bool isFixedwing);
+	int firstItem(size_t nMissionItems, uint8_t verdict);
+
 	/* Checks for all airframes */
-	bool checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence);
-	bool checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool home_valid, bool &warning_issued, bool throw_error = false);
+	bool checkGeofence(size_t nMissionItems);
+	bool checkHomePositionAltitude(size_t nMissionItems, bool &warning_issued, bool throw_error = false);
 	bool checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed);
 	bool check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon, float dist_first_wp, bool &warning_issued);
 	bool isPositionCommand(unsigned cmd);
+	bool isSupportedCommand(unsigned cmd);
+
+	/* Terrain along the route, only read when the check is enabled */
+	TerrainDatabase _terrain;
+	bool checkTerrainClearance(dm_item_t dm_current, size_t nMissionItems, float home_alt, float min_clearance);
 
 	/* Checks specific to fixedwing airframes */
-	bool checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid);
-	bool checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems);
+	bool checkMissionFeasibleFixedwing(dm_item_t dm_current, size_t nMissionItems);
+	bool checkFixedWingLanding(const struct mission_item_s &missionitem_previous,
+		const struct mission_item_s &missionitem, bool report);
 	void updateNavigationCapabilities();
 
 	/* Checks specific to rotarywing airframes */
-	bool checkMissionFeasibleRotarywing(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid, float default_acceptance_rad);
+	bool checkMissionFeasibleRotarywing(size_t nMissionItems);
+	bool checkTakeoffAltitude(const struct mission_item_s &missionitem, float home_alt, float default_acceptance_rad);
 public:
 
 	MissionFeasibilityChecker();
@@ -86,7 +129,7 @@ public:
 	bool checkMissionFeasible(orb_advert_t *mavlink_log_pub, bool isRotarywing, dm_item_t dm_current,
 		size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid,
 		double curr_lat, double curr_lon, float max_waypoint_distance, bool &warning_issued, float default_acceptance_rad,
-		bool condition_landed);
+		bool condition_landed, float min_terrain_clearance);
 
 };
 
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mission_item_cache.cpp
+ * Mission items read ahead from the dataman.
+ */
+
+#include "mission_item_cache.h"
+
+#include <string.h>
+
+MissionItemCache::MissionItemCache() :
+	_windows{},
+	_clock(0)
+{
+	invalidate();
+}
+
+void
+MissionItemCache::invalidate()
+{
+	for (unsigned i = 0; i < WINDOWS; i++) {
+		_windows[i].dm_item = DM_KEY_NUM_KEYS;
+		_windows[i].count = 0;
+	}
+}
+
+MissionItemCache::Window *
+MissionItemCache::find(dm_item_t dm_item, unsigned index)
+{
+	for (unsigned i = 0; i < WINDOWS; i++) {
+		Window &window = _windows[i];
+
+		if (window.dm_item == dm_item && index >= window.start && index < window.start + window.count) {
+			return &window;
+		}
+	}
+
+	return nullptr;
+}
+
+MissionItemCache::Window *
+MissionItemCache::fill(dm_item_t dm_item, unsigned count, unsigned index, const Window *keep)
+{
+	Window *victim = nullptr;
+
+	for (unsigned i = 0; i < WINDOWS; i++) {
+		if (&_windows[i] != keep && (victim == nullptr || (int)(_windows[i].last_use - victim->last_use) < 0)) {
+			victim = &_windows[i];
+		}
+	}
+
+	/* read ahead, but not past the end of the mission */
+	const unsigned items = (count - index < WINDOW_SIZE) ? count - index : WINDOW_SIZE;
+	const ssize_t res = dm_read_range(dm_item, index, items, victim->items, sizeof(struct mission_item_s));
+
+	if (res <= 0) {
+		victim->dm_item = DM_KEY_NUM_KEYS;
+		victim->count = 0;
+		return nullptr;
+	}
+
+	victim->dm_item = dm_item;
+	victim->start = index;
+	victim->count = res;
+	victim->last_use = _clock;
+
+	return victim;
+}
+
+bool
+MissionItemCache::read(dm_item_t dm_item, unsigned count, unsigned index, struct mission_item_s *item)
+{
+	if (index >= count) {
+		return false;
+	}
+
+	Window *window = find(dm_item, index);
+
+	if (window == nullptr) {
+		window = fill(dm_item, count, index, nullptr);
+
+		if (window == nullptr) {
+			return false;
+		}
+
+		/* resolve the first pending jump leaving the window */
+		for (unsigned i = 0; i < window->count; i++) {
+			const struct mission_item_s &jump = window->items[i];
+
+			if (jump.nav_cmd == NAV_CMD_DO_JUMP && jump.do_jump_current_count < jump.do_jump_repeat_count &&
+			    jump.do_jump_mission_index >= 0 && (unsigned)jump.do_jump_mission_index < count &&
+			    find(dm_item, jump.do_jump_mission_index) == nullptr) {
+				fill(dm_item, count, jump.do_jump_mission_index, window);
+				break;
+			}
+		}
+	}
+
+	window->last_use = ++_clock;
+	memcpy(item, &window->items[index - window->start], sizeof(struct mission_item_s));
+
+	return true;
+}
+
+bool
+MissionItemCache::write(dm_item_t dm_item, unsigned index, const struct mission_item_s *item)
+{
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_write(dm_item, index, DM_PERSIST_POWER_ON_RESET, item, len) != len) {
+		invalidate();
+		return false;
+	}
+
+	Window *window = find(dm_item, index);
+
+	if (window != nullptr) {
+		memcpy(&window->items[index - window->start], item, len);
+	}
+
+	return true;
+}
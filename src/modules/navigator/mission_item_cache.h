@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mission_item_cache.h
+ * Mission items read ahead from the dataman.
+ */
+
+#ifndef MISSION_ITEM_CACHE_H_
+#define MISSION_ITEM_CACHE_H_
+
+#include <navigator/navigation.h>
+#include <dataman/dataman.h>
+
+/**
+ * Windows of consecutive mission items held in RAM.
+ *
+ * A miss reads the requested item and the items following it in one
+ * request. If the window holds a DO_JUMP that still has repetitions left,
+ * the items at its target are read into another window right away, so
+ * that both the items after the jump and the jump target are available.
+ *
+ * The cache does not notice changes made by others to the dataman, it has
+ * to be invalidated whenever the mission changes.
+ */
+class MissionItemCache
+{
+public:
+	static constexpr unsigned WINDOW_SIZE = 8;	/**< items read ahead */
+	static constexpr unsigned WINDOWS = 2;		/**< one for the current items, one for a jump target */
+
+	MissionItemCache();
+
+	/**
+	 * Drop all items.
+	 */
+	void invalidate();
+
+	/**
+	 * Read a mission item.
+	 *
+	 * @param dm_item	Dataman item type of the mission.
+	 * @param count		Number of items in the mission, nothing past it is read.
+	 * @param index		Index of the item.
+	 * @param item		Set to the item.
+	 * @return		false if the item is out of range or cannot be read.
+	 */
+	bool read(dm_item_t dm_item, unsigned count, unsigned index, struct mission_item_s *item);
+
+	/**
+	 * Write a mission item to the dataman and update a cached copy.
+	 *
+	 * @return		false if the item cannot be written, all items are dropped then.
+	 */
+	bool write(dm_item_t dm_item, unsigned index, const struct mission_item_s *item);
+
+private:
+	struct Window {
+		dm_item_t dm_item;		/**< DM_KEY_NUM_KEYS if unused */
+		unsigned start;
+		unsigned count;
+		unsigned last_use;
+		struct mission_item_s items[WINDOW_SIZE];
+	};
+
+	Window _windows[WINDOWS];
+	unsigned _clock;
+
+	Window *find(dm_item_t dm_item, unsigned index);
+
+	/**
+	 * Read the items starting at index into the least recently used window other than keep.
+	 */
+	Window *fill(dm_item_t dm_item, unsigned count, unsigned index, const Window *keep);
+
+	/* do not allow copying this class */
+	MissionItemCache(const MissionItemCache &);
+	MissionItemCache &operator=(const MissionItemCache &);
+};
+
+#endif /* MISSION_ITEM_CACHE_H_ */
@@ -148,3 +148,18 @@ PARAM_DEFINE_FLOAT(MIS_YAW_TMT, -1.0f);
  * @group Mission
  */
 PARAM_DEFINE_FLOAT(MIS_YAW_ERR, 12.0f);
+
+/**
+ * Minimal terrain clearance of the mission route
+ *
+ * Missions are rejected if a leg between two waypoints comes closer to the terrain than
+ * this. The terrain is taken from the elevation tiles on the SD card, legs over areas
+ * without tiles are not checked. Set a value of zero or less to disable.
+ *
+ * @unit m
+ * @min 0
+ * @max 500
+ * @increment 1
+ * @group Mission
+ */
+PARAM_DEFINE_FLOAT(MIS_TERR_CLR, 0.0f);
@@ -349,6 +349,9 @@ Navigator::task_main()
 
 		perf_begin(_loop_perf);
 
+		/* apply fence changes made by the navigator command */
+		_geofence.update();
+
 		bool updated;
 
 		/* gps updated */
@@ -471,6 +474,7 @@ Navigator::task_main()
 			have_geofence_position_data = false;
 
 			_geofence_result.geofence_action = _geofence.getGeofenceAction();
+			_geofence_result.boundary_distance = _geofence.getBoundaryDistance();
 			if (!inside) {
 				/* inform other apps via the mission result */
 				_geofence_result.geofence_violated = true;
@@ -54,6 +54,7 @@
 #include <systemlib/err.h>
 #include <errno.h>
 #include <semaphore.h>
+#include <pthread.h>
 
 #include <sys/stat.h>
 
@@ -62,6 +63,7 @@
 #include "systemlib/param/param.h"
 #include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
+#include "systemlib/param/param_journal.h"
 
 #include "uORB/uORB.h"
 #include "uORB/topics/parameter_update.h"
@@ -97,6 +99,11 @@ static const struct param_info_s *param_info_base = (const struct param_info_s *
 
 #define	param_info_count		px4_parameters.param_count
 
+/* look up names through the perfect hash generated along with the parameter table */
+#if defined(PX4_PARAMETERS_HASH_SIZE) && !defined(_UNIT_TEST)
+#define PARAM_NAME_HASH
+#endif
+
 /**
  * Storage for modified parameters.
  */
@@ -111,6 +118,63 @@ uint8_t  *param_changed_storage = 0;
 int size_param_changed_storage_bytes = 0;
 const int bits_per_allocation_unit  = (sizeof(*param_changed_storage) * 8);
 
+/** sequence number of the most recent parameter change */
+static uint32_t param_change_sequence = 0;
+
+/** sequence number at boot, random so that numbers from an earlier boot are not mistaken for this one */
+static uint32_t param_change_seq_start = 0;
+
+/** lower 16 bits of the sequence number of the last change of each parameter */
+static uint16_t *param_change_seq_storage = NULL;
+
+/** cached result of param_hash_check(), kept up to date by param_set */
+static uint32_t param_hash = 0;
+static bool param_hash_valid = false;
+
+/** position + 1 of the changed value of each parameter in param_values, 0 if unchanged */
+static uint16_t *param_changed_slot = NULL;
+
+/** length of each parameter name, hashed by param_hash_check() and param_hash_apply() */
+static uint8_t *param_name_len = NULL;
+
+/**
+ * Current value of each parameter, read by param_get() without taking the lock.
+ * Writers only ever store single words here: the value of scalars or the
+ * storage pointer of structures.
+ */
+static volatile union param_value_u *param_current = NULL;
+
+/** odd while a writer copies a structure value in place */
+static volatile uint32_t param_struct_seq = 0;
+
+/**
+ * Structure storage of parameters that were reset. param_get() may still be
+ * copying from it, so it is never freed but handed out again on the next set.
+ */
+static UT_array *param_retired = NULL;
+
+
+/**
+ * Random start of the change sequence for this boot.
+ */
+static uint32_t
+param_random_seq(void)
+{
+	uint32_t seed = 0;
+	int fd = PARAM_OPEN("/dev/urandom", O_RDONLY);
+
+	if (fd >= 0) {
+		if (read(fd, &seed, sizeof(seed)) != sizeof(seed)) {
+			seed = 0;
+		}
+
+		PARAM_CLOSE(fd);
+	}
+
+	/* without a random device the boot timing jitter has to do */
+	hrt_abstime now = hrt_absolute_time();
+	return crc32part((const uint8_t *)&now, sizeof(now), seed);
+}
 
 static unsigned
 get_param_info_count(void)
@@ -128,6 +192,55 @@ get_param_info_count(void)
 		}
 	}
 
+	if (!param_change_seq_storage) {
+		param_change_seq_storage = calloc(param_info_count, sizeof(*param_change_seq_storage));
+
+		if (param_change_seq_storage == NULL) {
+			return 0;
+		}
+
+		param_change_seq_start = param_random_seq();
+		param_change_sequence = param_change_seq_start;
+
+		for (unsigned i = 0; i < param_info_count; i++) {
+			param_change_seq_storage[i] = (uint16_t)param_change_seq_start;
+		}
+	}
+
+	if (!param_changed_slot) {
+		param_changed_slot = calloc(param_info_count, sizeof(*param_changed_slot));
+
+		if (param_changed_slot == NULL) {
+			return 0;
+		}
+	}
+
+	if (!param_name_len) {
+		param_name_len = calloc(param_info_count, sizeof(*param_name_len));
+
+		if (param_name_len == NULL) {
+			return 0;
+		}
+
+		for (unsigned i = 0; i < param_info_count; i++) {
+			param_name_len[i] = strlen(param_info_base[i].name);
+		}
+	}
+
+	if (!param_current) {
+		union param_value_u *current = calloc(param_info_count, sizeof(*current));
+
+		if (current == NULL) {
+			return 0;
+		}
+
+		for (unsigned i = 0; i < param_info_count; i++) {
+			current[i] = param_info_base[i].val;
+		}
+
+		param_current = current;
+	}
+
 	return param_info_count;
 }
 
@@ -147,18 +260,27 @@ static void param_set_used_internal(param_t param);
 
 static param_t param_find_internal(const char *name, bool notification);
 
+static int param_import_internal(int fd, bool mark_saved, struct param_journal_s *journal);
+
+static int param_journal_save(const char *filename);
+static void param_journal_restart(int fd, uint32_t seq);
+static void param_journal_loaded(void);
+
+/** serializes writers, param_get() does not take it */
+static pthread_mutex_t param_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /** lock the parameter store */
 static void
 param_lock(void)
 {
-	//do {} while (px4_sem_wait(&param_sem) != 0);
+	pthread_mutex_lock(&param_mutex);
 }
 
 /** unlock the parameter store */
 static void
 param_unlock(void)
 {
-	//px4_sem_post(&param_sem);
+	pthread_mutex_unlock(&param_mutex);
 }
 
 /** assert that the parameter store is locked */
@@ -217,23 +339,214 @@ param_find_changed(param_t param)
 
 	param_assert_locked();
 
+	if (param_values != NULL && handle_in_range(param) && param_changed_slot[param] != 0) {
+		s = (struct param_wbuf_s *)utarray_eltptr(param_values, param_changed_slot[param] - 1u);
+	}
+
+	return s;
+}
+
+/**
+ * Rebuild the changed value positions after param_values was reordered.
+ */
+static void
+param_rebuild_slots(void)
+{
+	if (param_changed_slot == NULL) {
+		return;
+	}
+
+	memset(param_changed_slot, 0, get_param_info_count() * sizeof(*param_changed_slot));
+
 	if (param_values != NULL) {
-#if 0	/* utarray_find requires bsearch, not available */
-		struct param_wbuf_s key;
-		key.param = param;
-		s = utarray_find(param_values, &key, param_compare_values);
-#else
+		struct param_wbuf_s *s = NULL;
 
 		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
-			if (s->param == param) {
+			param_changed_slot[s->param] = utarray_eltidx(param_values, s) + 1;
+		}
+	}
+}
+
+/**
+ * Make a new value visible to param_get().
+ *
+ * @param param			The parameter that changed.
+ * @param val			Its new value, either the changed or the default one.
+ */
+static void
+param_publish(param_t param, const union param_value_u *val)
+{
+	if (param_type(param) == PARAM_TYPE_INT32 || param_type(param) == PARAM_TYPE_FLOAT) {
+		param_current[param].i = val->i;
+
+	} else {
+		/* the structure contents have to be visible before the pointer */
+		__sync_synchronize();
+		param_current[param].p = val->p;
+	}
+}
+
+/**
+ * Keep the structure storage of a changed value that is going away.
+ */
+static void
+param_retire_storage(const struct param_wbuf_s *s)
+{
+	if (param_type(s->param) < PARAM_TYPE_STRUCT || s->val.p == NULL) {
+		return;
+	}
+
+	if (param_retired == NULL) {
+		utarray_new(param_retired, &param_icd);
+	}
+
+	if (param_retired != NULL) {
+		utarray_push_back(param_retired, s);
+	}
+}
+
+/**
+ * Take back the structure storage a parameter had before it was reset.
+ */
+static void *
+param_reuse_storage(param_t param)
+{
+	struct param_wbuf_s *s = NULL;
+
+	if (param_retired == NULL) {
+		return NULL;
+	}
+
+	while ((s = (struct param_wbuf_s *)utarray_next(param_retired, s)) != NULL) {
+		if (s->param == param) {
+			void *p = s->val.p;
+			utarray_erase(param_retired, utarray_eltidx(param_retired, s), 1);
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Multiply two polynomials modulo the (bit reflected) CRC32 polynomial.
+ */
+static uint32_t
+param_crc32_multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = (uint32_t)1 << 31;
+	uint32_t p = 0;
+
+	for (;;) {
+		if (a & m) {
+			p ^= b;
+
+			if ((a & (m - 1)) == 0) {
 				break;
 			}
 		}
 
-#endif
+		m >>= 1;
+		b = (b & 1) ? (b >> 1) ^ 0xedb88320 : b >> 1;
 	}
 
-	return s;
+	return p;
+}
+
+/**
+ * Advance a CRC32 over len zero bytes in O(log(len)) steps.
+ *
+ * crc32part() has no pre- or post-inversion and is therefore linear in its
+ * input. Changing bytes in the middle of the hashed data changes the result
+ * by the CRC of the difference, shifted over all bytes following it.
+ */
+static uint32_t
+param_crc32_shift(uint32_t crc, size_t len)
+{
+	uint32_t sq = (uint32_t)1 << 23;	/* x^8, one zero byte */
+	uint32_t p = (uint32_t)1 << 31;		/* x^0 */
+
+	while (len > 0) {
+		if (len & 1) {
+			p = param_crc32_multmodp(sq, p);
+		}
+
+		len >>= 1;
+
+		if (len > 0) {
+			sq = param_crc32_multmodp(sq, sq);
+		}
+	}
+
+	return param_crc32_multmodp(p, crc);
+}
+
+/**
+ * Update the cached parameter hash for a changed value.
+ *
+ * The CRC shift is O(log n), counting the bytes hashed after the value is
+ * still a pass over the following parameters, but without any CRC work.
+ *
+ * @param param			The parameter that changed.
+ * @param old_val		The previous value.
+ * @param new_val		The new value.
+ */
+static void
+param_hash_apply(param_t param, const void *old_val, const void *new_val)
+{
+	if (!param_hash_valid || !param_used(param)) {
+		return;
+	}
+
+	const uint8_t *a = (const uint8_t *)old_val;
+	const uint8_t *b = (const uint8_t *)new_val;
+	uint32_t delta = 0;
+
+	for (size_t i = 0; i < param_size(param); i++) {
+		uint8_t d = a[i] ^ b[i];
+		delta = crc32part(&d, 1, delta);
+	}
+
+	/* count the bytes hashed after this value */
+	size_t trailing = 0;
+
+	for (param_t p = param + 1; handle_in_range(p); p++) {
+		if (param_used(p)) {
+			trailing += param_name_len[p] + param_size(p);
+		}
+	}
+
+	param_hash ^= param_crc32_shift(delta, trailing);
+}
+
+/**
+ * Record a change of a parameter value.
+ */
+static void
+param_mark_changed(param_t param)
+{
+	param_change_sequence++;
+	param_change_seq_storage[param] = (uint16_t)param_change_sequence;
+}
+
+/**
+ * Record a parameter returning to its default value.
+ *
+ * @param param			The parameter being reset.
+ * @param old_val		The value it had before.
+ */
+static void
+param_mark_reset(param_t param, const union param_value_u *old_val)
+{
+	if (param_type(param) == PARAM_TYPE_INT32 || param_type(param) == PARAM_TYPE_FLOAT) {
+		param_hash_apply(param, old_val, &param_info_base[param].val);
+
+	} else {
+		param_hash_valid = false;
+	}
+
+	param_publish(param, &param_info_base[param].val);
+	param_mark_changed(param);
 }
 
 static void
@@ -253,13 +566,48 @@ param_notify_changes(bool is_saved)
 	}
 }
 
+#ifdef PARAM_NAME_HASH
+/**
+ * 32 bit FNV-1a hash of a parameter name, must match Tools/px_generate_params.py.
+ */
+static uint32_t
+param_name_hash(uint32_t seed, const char *name)
+{
+	uint32_t h = seed ? seed : 0x811c9dc5;
+
+	while (*name) {
+		h ^= (uint8_t)*name++;
+		h *= 16777619;
+	}
+
+	return h;
+}
+#endif
+
 param_t
 param_find_internal(const char *name, bool notification)
 {
 	param_t param;
 
-	/* perform a linear search of the known parameters */
+#ifdef PARAM_NAME_HASH
+	/* the bucket holds either the seed that leads to the slot or the slot itself */
+	int16_t displace = px4_parameters_hash_displace[param_name_hash(0, name) % PX4_PARAMETERS_HASH_SIZE];
+	uint32_t slot = (displace < 0) ? (uint32_t)(-displace - 1) :
+			param_name_hash(displace, name) % PX4_PARAMETERS_HASH_SIZE;
 
+	param = px4_parameters_hash_index[slot];
+
+	if (handle_in_range(param) && !strcmp(param_info_base[param].name, name)) {
+		if (notification) {
+			param_set_used_internal(param);
+		}
+
+		return param;
+	}
+
+#else
+
+	/* perform a linear search of the known parameters */
 	for (param = 0; handle_in_range(param); param++) {
 		if (!strcmp(param_info_base[param].name, name)) {
 			if (notification) {
@@ -270,6 +618,8 @@ param_find_internal(const char *name, bool notification)
 		}
 	}
 
+#endif
+
 	/* not found */
 	return PARAM_INVALID;
 }
@@ -479,23 +829,47 @@ param_get_value_ptr(param_t param)
 	return result;
 }
 
-int
-param_get(param_t param, void *val)
+/**
+ * Copy the current value of a parameter without taking the lock.
+ */
+static int
+param_get_current(param_t param, void *val)
 {
-	int result = -1;
+	/* scalars are a single word, a concurrent writer cannot tear them */
+	if (param_type(param) == PARAM_TYPE_INT32 || param_type(param) == PARAM_TYPE_FLOAT) {
+		int32_t v = param_current[param].i;
+		memcpy(val, &v, sizeof(v));
+		return 0;
+	}
 
-	param_lock();
+	uint32_t seq = param_struct_seq;
+	__sync_synchronize();
 
-	const void *v = param_get_value_ptr(param);
+	if ((seq & 1) == 0) {
+		memcpy(val, (const void *)param_current[param].p, param_size(param));
+		__sync_synchronize();
 
-	if (val != NULL) {
-		memcpy(val, v, param_size(param));
-		result = 0;
+		if (seq == param_struct_seq) {
+			return 0;
+		}
 	}
 
+	/* a writer was copying a structure, wait for it instead of spinning */
+	param_lock();
+	memcpy(val, param_get_value_ptr(param), param_size(param));
 	param_unlock();
 
-	return result;
+	return 0;
+}
+
+int
+param_get(param_t param, void *val)
+{
+	if (val == NULL || !handle_in_range(param)) {
+		return -1;
+	}
+
+	return param_get_current(param, val);
 }
 
 static int
@@ -517,6 +891,14 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 	if (handle_in_range(param)) {
 
+		/* remember the previous value for change tracking and the hash */
+		const bool is_scalar = (param_type(param) == PARAM_TYPE_INT32 || param_type(param) == PARAM_TYPE_FLOAT);
+		union param_value_u old_val = { .p = NULL };
+
+		if (is_scalar) {
+			memcpy(&old_val, param_get_value_ptr(param), param_size(param));
+		}
+
 		struct param_wbuf_s *s = param_find_changed(param);
 
 		if (s == NULL) {
@@ -531,6 +913,7 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			/* add it to the array and sort */
 			utarray_push_back(param_values, &buf);
 			utarray_sort(param_values, param_compare_values);
+			param_rebuild_slots();
 
 			/* find it after sorting */
 			s = param_find_changed(param);
@@ -548,6 +931,10 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
+			if (s->val.p == NULL) {
+				s->val.p = param_reuse_storage(param);
+			}
+
 			if (s->val.p == NULL) {
 				s->val.p = malloc(param_size(param));
 
@@ -557,13 +944,30 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 				}
 			}
 
+			/* lets param_get() detect a torn copy */
+			param_struct_seq++;
+			__sync_synchronize();
 			memcpy(s->val.p, val, param_size(param));
+			__sync_synchronize();
+			param_struct_seq++;
 			break;
 
 		default:
 			goto out;
 		}
 
+		param_publish(param, &s->val);
+
+		if (!is_scalar) {
+			/* structures are not part of the incremental hash */
+			param_hash_valid = false;
+			param_mark_changed(param);
+
+		} else if (memcmp(&old_val, &s->val, param_size(param)) != 0) {
+			param_hash_apply(param, &old_val, &s->val);
+			param_mark_changed(param);
+		}
+
 		s->unsaved = !mark_saved;
 		params_changed = true;
 		result = 0;
@@ -622,6 +1026,11 @@ void param_set_used_internal(param_t param)
 		return;
 	}
 
+	/* the hash covers used parameters only */
+	if (!param_used(param)) {
+		param_hash_valid = false;
+	}
+
 	param_changed_storage[param_index / bits_per_allocation_unit] |=
 		(1 << param_index % bits_per_allocation_unit);
 }
@@ -641,8 +1050,12 @@ param_reset(param_t param)
 
 		/* if we found one, erase it */
 		if (s != NULL) {
+			param_mark_reset(param, &s->val);
+			param_retire_storage(s);
+
 			int pos = utarray_eltidx(param_values, s);
 			utarray_erase(param_values, pos, 1);
+			param_rebuild_slots();
 		}
 
 		param_found = true;
@@ -663,11 +1076,22 @@ param_reset_all(void)
 	param_lock();
 
 	if (param_values != NULL) {
+		struct param_wbuf_s *s = NULL;
+
+		/* every modified parameter returns to its default */
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			param_publish(s->param, &param_info_base[s->param].val);
+			param_mark_changed(s->param);
+			param_retire_storage(s);
+		}
+
 		utarray_free(param_values);
 	}
 
 	/* mark as reset / deleted */
 	param_values = NULL;
+	param_rebuild_slots();
+	param_hash_valid = false;
 
 	param_unlock();
 
@@ -677,8 +1101,6 @@ param_reset_all(void)
 void
 param_reset_excludes(const char *excludes[], int num_excludes)
 {
-	param_lock();
-
 	param_t	param;
 
 	for (param = 0; handle_in_range(param); param++) {
@@ -701,14 +1123,15 @@ param_reset_excludes(const char *excludes[], int num_excludes)
 		}
 	}
 
-	param_unlock();
-
 	param_notify_changes(false);
 }
 
 static const char *param_default_file = PX4_ROOTFSDIR"/eeprom/parameters";
 static char *param_user_file = NULL;
 
+/** journal of the default parameter file */
+static struct param_journal_s param_journal = { .end = -1, .size = 0, .generation = 0, .seq = 0 };
+
 int
 param_set_default_file(const char *filename)
 {
@@ -721,6 +1144,9 @@ param_set_default_file(const char *filename)
 		param_user_file = strdup(filename);
 	}
 
+	/* the journal position belongs to the previous file */
+	param_journal.end = -1;
+
 	return 0;
 }
 
@@ -738,6 +1164,11 @@ param_save_default(void)
 
 	const char *filename = param_get_default_file();
 
+	/* most saves only touch a few parameters, append those to the journal */
+	if (param_journal_save(filename) == OK) {
+		return OK;
+	}
+
 	/* write parameters to temp file */
 	fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
 
@@ -748,14 +1179,20 @@ param_save_default(void)
 
 	res = 1;
 	int attempts = 5;
+	const uint32_t seq = param_change_seq();
 
 	while (res != OK && attempts > 0) {
+		lseek(fd, 0, SEEK_SET);
 		res = param_export(fd, false);
 		attempts--;
 	}
 
 	if (res != OK) {
 		warnx("failed to write parameters to file: %s", filename);
+		param_journal.end = -1;
+
+	} else {
+		param_journal_restart(fd, seq);
 	}
 
 	PARAM_CLOSE(fd);
@@ -782,9 +1219,12 @@ param_load_default(void)
 		return 1;
 	}
 
-	int result = param_load(fd_load);
+	param_reset_all();
+	int result = param_import_internal(fd_load, true, &param_journal);
 	PARAM_CLOSE(fd_load);
 
+	param_journal_loaded();
+
 	if (result != 0) {
 		warn("error reading parameters from '%s'", param_get_default_file());
 		return -2;
@@ -825,6 +1265,127 @@ param_bus_lock(bool lock)
 #endif
 }
 
+/**
+ * Append all changes since the last save to the journal of the default file.
+ *
+ * @return		OK if the file is up to date, otherwise it has to be rewritten.
+ */
+static int
+param_journal_save(const char *filename)
+{
+	int result = ERROR;
+
+	if (param_journal.end < 0) {
+		return ERROR;
+	}
+
+	const uint32_t seq = param_change_seq();
+
+	/* only the lower 16 bits of the sequence are kept per parameter */
+	if (seq - param_journal.seq > UINT16_MAX) {
+		return ERROR;
+	}
+
+	int fd = PARAM_OPEN(filename, O_WRONLY);
+
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	if (lseek(fd, param_journal.end, SEEK_SET) != param_journal.end) {
+		goto out;
+	}
+
+	param_lock();
+
+	result = OK;
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+
+		if (!param_changed_since(param, param_journal.seq)) {
+			continue;
+		}
+
+		/* parameters without a changed value went back to their default */
+		struct param_wbuf_s *s = param_find_changed(param);
+		const size_t len = (s != NULL) ? param_size(param) : 0;
+
+		/* rewrite the file once the journal gets too long to replay quickly */
+		if (param_journal.size + param_journal_record_size(param_name(param), len) > PARAM_JOURNAL_MAX_SIZE) {
+			result = ERROR;
+			break;
+		}
+
+		param_bus_lock(true);
+		int ret = param_journal_append(fd, &param_journal, param_name(param), param_type(param),
+					       (s != NULL) ? param_get_value_ptr(param) : NULL, len);
+		param_bus_lock(false);
+
+		if (ret != 0) {
+			result = ERROR;
+			break;
+		}
+
+		if (s != NULL) {
+			s->unsaved = false;
+		}
+
+		/* allow this process to be interrupted by another process / thread */
+		usleep(5);
+	}
+
+	param_unlock();
+
+out:
+
+	if (result == OK && px4_fsync(fd) != 0) {
+		result = ERROR;
+	}
+
+	PARAM_CLOSE(fd);
+
+	if (result == OK) {
+		param_journal.seq = seq;
+
+	} else {
+		/* partially written records are dropped by the rewrite */
+		param_journal.end = -1;
+	}
+
+	return result;
+}
+
+/**
+ * Start a new journal behind a freshly written BSON document.
+ */
+static void
+param_journal_restart(int fd, uint32_t seq)
+{
+	/* a new generation invalidates leftovers of the previous journal */
+	param_bus_lock(true);
+	int ret = param_journal_begin(fd, &param_journal, param_journal.generation + 1);
+	param_bus_lock(false);
+
+	if (ret == 0) {
+		px4_fsync(fd);
+		param_journal.seq = seq;
+	}
+}
+
+/**
+ * Take over the journal state after loading the default file.
+ */
+static void
+param_journal_loaded(void)
+{
+	param_journal.seq = param_change_seq();
+
+	if (param_journal.end < 0) {
+		/* the previous generation is unknown, make a match with leftovers unlikely */
+		param_journal.generation = (uint32_t)hrt_absolute_time();
+	}
+}
+
 int
 param_export(int fd, bool only_unsaved)
 {
@@ -1037,8 +1598,30 @@ out:
 	return result;
 }
 
+/**
+ * Replay callback for the journal behind the BSON document.
+ */
+static void
+param_journal_apply(void *priv, const char *name, param_type_t type, const void *val, size_t len)
+{
+	struct param_import_state *state = (struct param_import_state *)priv;
+	param_t param = param_find_no_notification(name);
+
+	if (param == PARAM_INVALID || param_type(param) != type) {
+		debug("ignoring journal record for '%s'", name);
+		return;
+	}
+
+	if (val == NULL) {
+		param_reset(param);
+
+	} else if (len == param_size(param)) {
+		param_set_internal(param, val, state->mark_saved, true, false);
+	}
+}
+
 static int
-param_import_internal(int fd, bool mark_saved)
+param_import_internal(int fd, bool mark_saved, struct param_journal_s *journal)
 {
 	struct bson_decoder_s decoder;
 	int result = -1;
@@ -1064,8 +1647,19 @@ param_import_internal(int fd, bool mark_saved)
 
 	} while (result > 0);
 
+	/* changes saved after the document was written follow it directly */
+	if (result == 0) {
+		struct param_journal_s scratch;
+
+		result = param_journal_replay(fd, (journal != NULL) ? journal : &scratch, param_journal_apply, &state);
+	}
+
 out:
 
+	if (result != 0 && journal != NULL) {
+		journal->end = -1;
+	}
+
 	if (result < 0) {
 		debug("BSON error decoding parameters");
 	}
@@ -1076,14 +1670,14 @@ out:
 int
 param_import(int fd)
 {
-	return param_import_internal(fd, false);
+	return param_import_internal(fd, false, NULL);
 }
 
 int
 param_load(int fd)
 {
 	param_reset_all();
-	return param_import_internal(fd, true);
+	return param_import_internal(fd, true, NULL);
 }
 
 void
@@ -1108,23 +1702,75 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 
 uint32_t param_hash_check(void)
 {
-	uint32_t param_hash = 0;
-
 	param_lock();
 
-	/* compute the CRC32 over all string param names and 4 byte values */
-	for (param_t param = 0; handle_in_range(param); param++) {
-		if (!param_used(param)) {
-			continue;
+	if (!param_hash_valid) {
+		uint32_t hash = 0;
+
+		/* compute the CRC32 over all string param names and 4 byte values */
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (!param_used(param)) {
+				continue;
+			}
+
+			const char *name = param_name(param);
+			const void *val = param_get_value_ptr(param);
+			hash = crc32part((const uint8_t *)name, param_name_len[param], hash);
+			hash = crc32part(val, param_size(param), hash);
 		}
 
-		const char *name = param_name(param);
-		const void *val = param_get_value_ptr(param);
-		param_hash = crc32part((const uint8_t *)name, strlen(name), param_hash);
-		param_hash = crc32part(val, param_size(param), param_hash);
+		param_hash = hash;
+		param_hash_valid = true;
 	}
 
+	uint32_t result = param_hash;
+
 	param_unlock();
 
-	return param_hash;
+	return result;
+}
+
+uint32_t param_change_seq(void)
+{
+	return param_change_sequence;
+}
+
+bool param_change_seq_valid(uint32_t seq)
+{
+	/* unsigned distances, so this also holds across a wrap of the sequence */
+	return (param_change_sequence - seq) <= (param_change_sequence - param_change_seq_start);
+}
+
+bool param_changed_since(param_t param, uint32_t seq)
+{
+	if (!handle_in_range(param)) {
+		return false;
+	}
+
+	uint32_t age = param_change_sequence - seq;
+
+	/* only 16 bits are stored per parameter, older requests cannot be told apart */
+	if (age > UINT16_MAX) {
+		return true;
+	}
+
+	uint16_t since = param_change_seq_storage[param] - (uint16_t)seq;
+
+	return since != 0 && since <= age;
+}
+
+bool param_any_changed_since(const param_t *params, unsigned count, uint32_t seq)
+{
+	/* nothing changed at all, common case for periodic polling */
+	if (seq == param_change_sequence) {
+		return false;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		if (param_changed_since(params[i], seq)) {
+			return true;
+		}
+	}
+
+	return false;
 }
@@ -335,7 +335,9 @@ __EXPORT const char	*param_get_default_file(void);
 /**
  * Save parameters to the default file.
  *
- * This function saves all parameters with non-default values.
+ * This function saves all parameters with non-default values. Parameters
+ * changed since the last save are appended to a journal behind the saved
+ * values, the whole file is only rewritten once the journal is full.
  *
  * @return		Zero on success.
  */
@@ -355,6 +357,53 @@ __EXPORT int 		param_load_default(void);
  */
 __EXPORT uint32_t	param_hash_check(void);
 
+/**
+ * Get the current parameter change sequence number.
+ *
+ * The sequence number is incremented on every change of a parameter value,
+ * including resets to the default. It starts at a random value on every boot,
+ * use param_change_seq_valid() on numbers that come from outside.
+ *
+ * @return		The sequence number of the most recent change
+ */
+__EXPORT uint32_t	param_change_seq(void);
+
+/**
+ * Test whether a sequence number belongs to this boot.
+ *
+ * Numbers kept by a client across a reboot cannot be compared with the
+ * current sequence, the client has to fetch all parameters again.
+ *
+ * @param seq		A sequence number previously returned by param_change_seq().
+ * @return		True if seq was handed out since boot
+ */
+__EXPORT bool		param_change_seq_valid(uint32_t seq);
+
+/**
+ * Test whether a parameter has changed after a given sequence number.
+ *
+ * Only the lower 16 bits of the sequence are stored per parameter, so this can
+ * report false positives for very old sequence numbers, but never misses a change.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param seq		A sequence number previously returned by param_change_seq().
+ * @return		True if the value changed after seq
+ */
+__EXPORT bool		param_changed_since(param_t param, uint32_t seq);
+
+/**
+ * Test whether any parameter of a set has changed after a given sequence number.
+ *
+ * Modules can use this on a parameter_update notification to skip reloading
+ * their parameters when only unrelated parameters were changed.
+ *
+ * @param params	Array of handles, PARAM_INVALID entries are ignored.
+ * @param count		Number of handles in params.
+ * @param seq		A sequence number previously returned by param_change_seq().
+ * @return		True if at least one of the parameters changed after seq
+ */
+__EXPORT bool		param_any_changed_since(const param_t *params, unsigned count, uint32_t seq);
+
 /*
  * Macros creating static parameter definitions.
  *
@@ -0,0 +1,276 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_journal.c
+ *
+ * Append-only journal of parameter changes.
+ */
+
+#include <px4_defines.h>
+#include <px4_posix.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <crc32.h>
+
+#include "param_journal.h"
+
+#if 0
+# define debug(fmt, args...)		do { warnx(fmt, ##args); } while(0)
+#else
+# define debug(fmt, args...)		do { } while(0)
+#endif
+
+/** longest parameter name accepted in a record */
+#define PARAM_JOURNAL_NAME_MAX	64
+
+enum param_journal_kind_e {
+	PARAM_JOURNAL_BEGIN = 0x4a,	/**< start of a journal, value is the generation */
+	PARAM_JOURNAL_SET,		/**< parameter set to the value */
+	PARAM_JOURNAL_RESET		/**< parameter reset to its default, no value */
+};
+
+/**
+ * Record header, followed by the name (not terminated) and the value.
+ */
+struct param_journal_header_s {
+	uint32_t	crc;		/**< CRC32 of the rest of the record, seeded with the generation */
+	uint16_t	len;		/**< size of the value */
+	uint16_t	type;		/**< param_type_t of the parameter */
+	uint8_t		name_len;
+	uint8_t		kind;		/**< param_journal_kind_e */
+	uint16_t	reserved;
+};
+
+static uint32_t
+param_journal_crc(const struct param_journal_header_s *hdr, const char *name, const void *val, uint32_t seed)
+{
+	/* everything after the crc field */
+	uint32_t crc = crc32part((const uint8_t *)&hdr->len, sizeof(*hdr) - sizeof(hdr->crc), seed);
+	crc = crc32part((const uint8_t *)name, hdr->name_len, crc);
+	return crc32part((const uint8_t *)val, hdr->len, crc);
+}
+
+static int
+param_journal_write(int fd, struct param_journal_s *journal, uint8_t kind, const char *name,
+		    param_type_t type, const void *val, size_t len, uint32_t seed)
+{
+	size_t name_len = strlen(name);
+
+	if (name_len >= PARAM_JOURNAL_NAME_MAX || len > UINT16_MAX) {
+		return -1;
+	}
+
+	/* header and name go out in one write, a torn record fails the CRC */
+	uint8_t buf[sizeof(struct param_journal_header_s) + PARAM_JOURNAL_NAME_MAX];
+	struct param_journal_header_s hdr = {
+		.crc = 0,
+		.len = len,
+		.type = type,
+		.name_len = name_len,
+		.kind = kind,
+		.reserved = 0
+	};
+
+	hdr.crc = param_journal_crc(&hdr, name, val, seed);
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(&buf[sizeof(hdr)], name, name_len);
+
+	const ssize_t head = sizeof(hdr) + name_len;
+
+	if (write(fd, buf, head) != head) {
+		debug("journal header write failed");
+		return -1;
+	}
+
+	if (len > 0 && write(fd, val, len) != (ssize_t)len) {
+		debug("journal value write failed");
+		return -1;
+	}
+
+	journal->end += head + len;
+	journal->size += head + len;
+
+	return 0;
+}
+
+int
+param_journal_begin(int fd, struct param_journal_s *journal, uint32_t generation)
+{
+	off_t start = lseek(fd, 0, SEEK_CUR);
+
+	if (start < 0) {
+		return -1;
+	}
+
+	journal->end = start;
+	journal->size = 0;
+
+	/* the begin record itself cannot be seeded with the generation it carries */
+	if (param_journal_write(fd, journal, PARAM_JOURNAL_BEGIN, "", PARAM_TYPE_UNKNOWN,
+				&generation, sizeof(generation), 0) != 0) {
+		journal->end = -1;
+		return -1;
+	}
+
+	journal->generation = generation;
+
+	return 0;
+}
+
+size_t
+param_journal_record_size(const char *name, size_t len)
+{
+	return sizeof(struct param_journal_header_s) + strlen(name) + len;
+}
+
+int
+param_journal_append(int fd, struct param_journal_s *journal, const char *name,
+		     param_type_t type, const void *val, size_t len)
+{
+	if (journal->end < 0) {
+		return -1;
+	}
+
+	if (val == NULL) {
+		return param_journal_write(fd, journal, PARAM_JOURNAL_RESET, name, type, NULL, 0, journal->generation);
+	}
+
+	return param_journal_write(fd, journal, PARAM_JOURNAL_SET, name, type, val, len, journal->generation);
+}
+
+/**
+ * Read the next record.
+ *
+ * @param value		Set to the value, either in scratch or a buffer that has to be freed.
+ * @return		True if a complete and valid record was read.
+ */
+static bool
+param_journal_read(int fd, struct param_journal_header_s *hdr, char *name, void *scratch, size_t scratch_len,
+		   void **value, uint32_t seed)
+{
+	*value = NULL;
+
+	if (read(fd, hdr, sizeof(*hdr)) != sizeof(*hdr) ||
+	    hdr->name_len >= PARAM_JOURNAL_NAME_MAX ||
+	    hdr->reserved != 0) {
+		return false;
+	}
+
+	if (read(fd, name, hdr->name_len) != hdr->name_len) {
+		return false;
+	}
+
+	name[hdr->name_len] = '\0';
+
+	if (hdr->len > scratch_len) {
+		*value = malloc(hdr->len);
+
+		if (*value == NULL) {
+			return false;
+		}
+
+	} else {
+		*value = scratch;
+	}
+
+	if (read(fd, *value, hdr->len) != hdr->len ||
+	    param_journal_crc(hdr, name, *value, seed) != hdr->crc) {
+		if (*value != scratch) {
+			free(*value);
+		}
+
+		*value = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+int
+param_journal_replay(int fd, struct param_journal_s *journal, param_journal_callback callback, void *priv)
+{
+	struct param_journal_header_s hdr;
+	char name[PARAM_JOURNAL_NAME_MAX];
+	union param_value_u scratch;
+	void *value;
+
+	journal->end = -1;
+	journal->size = 0;
+
+	off_t start = lseek(fd, 0, SEEK_CUR);
+
+	if (start < 0) {
+		return -1;
+	}
+
+	/* files written before the journal existed end with the BSON document */
+	if (!param_journal_read(fd, &hdr, name, &scratch, sizeof(scratch), &value, 0)) {
+		debug("no journal");
+		return 0;
+	}
+
+	if (hdr.kind != PARAM_JOURNAL_BEGIN || hdr.len != sizeof(journal->generation)) {
+		if (value != &scratch) {
+			free(value);
+		}
+
+		return 0;
+	}
+
+	memcpy(&journal->generation, value, sizeof(journal->generation));
+	journal->size = sizeof(hdr) + hdr.name_len + hdr.len;
+
+	/* stop at the first record that is torn or belongs to an older generation */
+	while (param_journal_read(fd, &hdr, name, &scratch, sizeof(scratch), &value, journal->generation)) {
+
+		if (hdr.kind == PARAM_JOURNAL_SET) {
+			callback(priv, name, (param_type_t)hdr.type, value, hdr.len);
+
+		} else if (hdr.kind == PARAM_JOURNAL_RESET) {
+			callback(priv, name, (param_type_t)hdr.type, NULL, 0);
+		}
+
+		journal->size += sizeof(hdr) + hdr.name_len + hdr.len;
+
+		if (value != &scratch) {
+			free(value);
+		}
+	}
+
+	journal->end = start + journal->size;
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file param_journal.h
+ *
+ * Append-only journal of parameter changes.
+ *
+ * The journal directly follows the BSON document in the parameter file.
+ * It starts with a begin record holding the generation of the journal,
+ * followed by one record per changed or reset parameter. Every record
+ * carries a CRC seeded with the generation, so replay stops at the first
+ * torn record as well as at leftovers of an older, longer journal.
+ *
+ * A full rewrite of the file (compaction) starts a new generation.
+ */
+
+#ifndef _SYSTEMLIB_PARAM_PARAM_JOURNAL_H
+#define _SYSTEMLIB_PARAM_PARAM_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "param.h"
+
+/** Journal size after which the parameter file is rewritten instead */
+#define PARAM_JOURNAL_MAX_SIZE	1024
+
+__BEGIN_DECLS
+
+/**
+ * Journal position in the parameter file.
+ */
+struct param_journal_s {
+	int32_t		end;		/**< file offset after the last record, -1 if there is no journal */
+	uint32_t	size;		/**< bytes used by the journal */
+	uint32_t	generation;	/**< generation of the records */
+	uint32_t	seq;		/**< parameter change sequence the file contents correspond to */
+};
+
+/**
+ * Called for every valid record during replay.
+ *
+ * @param priv		Private pointer passed to param_journal_replay.
+ * @param name		Parameter name.
+ * @param type		Parameter type stored in the record.
+ * @param val		New value, NULL if the parameter was reset to its default.
+ * @param len		Size of the value.
+ */
+typedef void (*param_journal_callback)(void *priv, const char *name, param_type_t type, const void *val, size_t len);
+
+/**
+ * Start a new journal at the current file position.
+ *
+ * @param fd		File descriptor, positioned after the BSON document.
+ * @param journal	Journal state, updated on success.
+ * @param generation	Generation of the new journal, must differ from the previous one.
+ * @return		Zero on success.
+ */
+__EXPORT int		param_journal_begin(int fd, struct param_journal_s *journal, uint32_t generation);
+
+/**
+ * Size of a record on disk.
+ *
+ * @param name		Parameter name.
+ * @param len		Size of the value, zero for a reset record.
+ */
+__EXPORT size_t		param_journal_record_size(const char *name, size_t len);
+
+/**
+ * Append a record at the current file position.
+ *
+ * @param fd		File descriptor, positioned at journal->end.
+ * @param journal	Journal state, updated on success.
+ * @param name		Parameter name.
+ * @param type		Parameter type.
+ * @param val		New value or NULL if the parameter was reset.
+ * @param len		Size of the value.
+ * @return		Zero on success.
+ */
+__EXPORT int		param_journal_append(int fd, struct param_journal_s *journal, const char *name,
+		param_type_t type, const void *val, size_t len);
+
+/**
+ * Replay the journal starting at the current file position.
+ *
+ * A file without a journal is not an error, journal->end is set to -1 then.
+ *
+ * @param fd		File descriptor, positioned after the BSON document.
+ * @param journal	Set to the state of the replayed journal.
+ * @param callback	Called for every valid record.
+ * @param priv		Passed to the callback.
+ * @return		Zero on success, -1 on read errors.
+ */
+__EXPORT int		param_journal_replay(int fd, struct param_journal_s *journal, param_journal_callback callback,
+		void *priv);
+
+__END_DECLS
+
+#endif /* _SYSTEMLIB_PARAM_PARAM_JOURNAL_H */
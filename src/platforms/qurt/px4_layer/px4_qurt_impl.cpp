@@ -146,6 +146,13 @@ dm_write(
 	return 0;
 }
 
+/** Write all cached changes to the physical media */
+int
+dm_flush(void)
+{
+	return 0;
+}
+
 size_t strnlen(const char *s, size_t maxlen)
 {
 	size_t i = 0;
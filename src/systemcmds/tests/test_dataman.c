@@ -135,8 +135,20 @@ task_main(int argc, char *argv[])
 	}
 
 	rend = hrt_absolute_time();
-	warnx("Test %d pass, hit %d, miss %d, io time read %llums. write %llums.",
-	      my_id, hit, miss, (rend - rstart) / NUM_MISSIONS_SUPPORTED / 1000, (wend - wstart) / NUM_MISSIONS_SUPPORTED / 1000);
+
+	/* the writes above are cached, include the time it takes to get them to the media */
+	hrt_abstime fstart = hrt_absolute_time();
+
+	if (dm_flush() != 0) {
+		warnx("%d flush failed", my_id);
+		goto fail;
+	}
+
+	hrt_abstime fend = hrt_absolute_time();
+
+	warnx("Test %d pass, hit %d, miss %d, io time read %lluus. write %lluus. flush %lluus.",
+	      my_id, hit, miss, (rend - rstart) / NUM_MISSIONS_SUPPORTED, (wend - wstart) / NUM_MISSIONS_SUPPORTED,
+	      fend - fstart);
 	px4_sem_post(sems + my_id);
 	return 0;
 fail:
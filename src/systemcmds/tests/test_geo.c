@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_geo.c
+ *
+ * Tests and benchmarks of the batch geo functions against the per point ones.
+ */
+
+#include <px4_defines.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <drivers/drv_hrt.h>
+#include <geo/geo.h>
+#include "systemlib/err.h"
+#include "tests.h"
+
+#define GEO_POINTS	500
+#define GEO_RUNS	10
+
+static double lat[GEO_POINTS];
+static double lon[GEO_POINTS];
+static float x_ref[GEO_POINTS];
+static float y_ref[GEO_POINTS];
+static float x_batch[GEO_POINTS];
+static float y_batch[GEO_POINTS];
+static double lat_batch[GEO_POINTS];
+static double lon_batch[GEO_POINTS];
+
+static void
+report(const char *name, hrt_abstime scalar, hrt_abstime batch)
+{
+	printf("  %-10s scalar %6u us, batch %6u us for %u points\n", name,
+	       (unsigned)(scalar / GEO_RUNS), (unsigned)(batch / GEO_RUNS), GEO_POINTS);
+}
+
+int
+test_geo(int argc, char *argv[])
+{
+	struct map_projection_reference_s ref;
+	map_projection_init(&ref, 47.397742, 8.545594);
+
+	/* points within about 20 km of the reference, like a mission or a fence */
+	srand(42);
+
+	for (unsigned i = 0; i < GEO_POINTS; i++) {
+		lat[i] = 47.397742 + ((double)rand() / RAND_MAX - 0.5) * 0.4;
+		lon[i] = 8.545594 + ((double)rand() / RAND_MAX - 0.5) * 0.6;
+	}
+
+	int ret = 0;
+	hrt_abstime start;
+	hrt_abstime scalar;
+	hrt_abstime batch;
+
+	/* projection */
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		for (unsigned i = 0; i < GEO_POINTS; i++) {
+			map_projection_project(&ref, lat[i], lon[i], &x_ref[i], &y_ref[i]);
+		}
+	}
+
+	scalar = hrt_elapsed_time(&start);
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		map_projection_project_batch(&ref, lat, lon, x_batch, y_batch, GEO_POINTS);
+	}
+
+	batch = hrt_elapsed_time(&start);
+	report("project", scalar, batch);
+
+	for (unsigned i = 0; i < GEO_POINTS; i++) {
+		if (fabsf(x_batch[i] - x_ref[i]) > 0.01f || fabsf(y_batch[i] - y_ref[i]) > 0.01f) {
+			warnx("project mismatch at %u: %.3f %.3f vs %.3f %.3f", i,
+			      (double)x_batch[i], (double)y_batch[i], (double)x_ref[i], (double)y_ref[i]);
+			ret = 1;
+			break;
+		}
+	}
+
+	/* points beyond 600 km, which do not use the series of the batch projection */
+	static const double far_lat[] = { 53.5, 41.9, 47.4, 30.0, -33.9 };
+	static const double far_lon[] = { 8.5, 12.5, 18.0, 31.2, 151.2 };
+	const unsigned far_points = sizeof(far_lat) / sizeof(far_lat[0]);
+	float x_far[sizeof(far_lat) / sizeof(far_lat[0])];
+	float y_far[sizeof(far_lat) / sizeof(far_lat[0])];
+
+	map_projection_project_batch(&ref, far_lat, far_lon, x_far, y_far, far_points);
+
+	for (unsigned i = 0; i < far_points; i++) {
+		float x_far_ref;
+		float y_far_ref;
+		map_projection_project(&ref, far_lat[i], far_lon[i], &x_far_ref, &y_far_ref);
+
+		/* relative to the distance, the float result resolves about 1e-7 of it */
+		float tolerance = 1e-5f * sqrtf(x_far_ref * x_far_ref + y_far_ref * y_far_ref);
+
+		if (fabsf(x_far[i] - x_far_ref) > tolerance || fabsf(y_far[i] - y_far_ref) > tolerance) {
+			warnx("far project mismatch at %u: %.1f %.1f vs %.1f %.1f", i,
+			      (double)x_far[i], (double)y_far[i], (double)x_far_ref, (double)y_far_ref);
+			ret = 1;
+			break;
+		}
+	}
+
+	/* reprojection of the projected points */
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		for (unsigned i = 0; i < GEO_POINTS; i++) {
+			map_projection_reproject(&ref, x_ref[i], y_ref[i], &lat_batch[i], &lon_batch[i]);
+		}
+	}
+
+	scalar = hrt_elapsed_time(&start);
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		map_projection_reproject_batch(&ref, x_ref, y_ref, lat_batch, lon_batch, GEO_POINTS);
+	}
+
+	batch = hrt_elapsed_time(&start);
+	report("reproject", scalar, batch);
+
+	for (unsigned i = 0; i < GEO_POINTS; i++) {
+		/* float coordinates resolve about a millimeter at this range */
+		if (fabs(lat_batch[i] - lat[i]) > 1e-6 || fabs(lon_batch[i] - lon[i]) > 1e-6) {
+			warnx("reproject mismatch at %u", i);
+			ret = 1;
+			break;
+		}
+	}
+
+	/* distances */
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		for (unsigned i = 0; i < GEO_POINTS; i++) {
+			x_ref[i] = get_distance_to_next_waypoint(47.397742, 8.545594, lat[i], lon[i]);
+		}
+	}
+
+	scalar = hrt_elapsed_time(&start);
+	start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < GEO_RUNS; r++) {
+		get_distance_to_next_waypoint_batch(47.397742, 8.545594, lat, lon, x_batch, GEO_POINTS);
+	}
+
+	batch = hrt_elapsed_time(&start);
+	report("distance", scalar, batch);
+
+	for (unsigned i = 0; i < GEO_POINTS; i++) {
+		if (fabsf(x_batch[i] - x_ref[i]) > 0.01f) {
+			warnx("distance mismatch at %u: %.3f vs %.3f", i, (double)x_batch[i], (double)x_ref[i]);
+			ret = 1;
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		warnx("geo test PASS");
+	}
+
+	return ret;
+}
@@ -38,7 +38,12 @@
  */
 
 #include <px4_defines.h>
+#include <px4_tasks.h>
 #include <stdio.h>
+#include <pthread.h>
+#include <limits.h>
+#include <unistd.h>
+#include <drivers/drv_hrt.h>
 #include "systemlib/err.h"
 #include "systemlib/param/param.h"
 #include "tests.h"
@@ -83,6 +88,15 @@ test_param(int argc, char *argv[])
 		return 1;
 	}
 
+	uint32_t hash = param_hash_check();
+	uint32_t seq = param_change_seq();
+
+	/* numbers not handed out yet, like those from before a reboot, are rejected */
+	if (!param_change_seq_valid(seq) || param_change_seq_valid(seq + 1)) {
+		warnx("change sequence validity mismatch");
+		return 1;
+	}
+
 	val = PARAM_MAGIC2;
 
 	if (param_set(p, &val) != OK) {
@@ -100,7 +114,215 @@ test_param(int argc, char *argv[])
 		return 1;
 	}
 
+	if (!param_changed_since(p, seq) || param_changed_since(p, param_change_seq())) {
+		warnx("change sequence mismatch after write");
+		return 1;
+	}
+
+	param_t set[] = { PARAM_INVALID, p };
+
+	if (!param_any_changed_since(set, 2, seq) || param_any_changed_since(set, 1, seq)) {
+		warnx("change notification mismatch after write");
+		return 1;
+	}
+
+	if (param_hash_check() == hash) {
+		warnx("parameter hash not updated after write");
+		return 1;
+	}
+
+	/* the incrementally updated hash has to match the original one again */
+	if (param_reset(p) != OK || param_hash_check() != hash) {
+		warnx("parameter hash mismatch after reset");
+		return 1;
+	}
+
 	warnx("parameter test PASS");
 
 	return 0;
 }
+
+#define CONTENTION_READERS	3
+#define CONTENTION_DURATION	2000000		/**< duration of each benchmark run in us */
+#define CONTENTION_STACK	2000
+
+static struct {
+	volatile bool	run;
+	bool		locked;		/**< readers and writer share a lock */
+	pthread_mutex_t	lock;
+	param_t		param;
+} contention = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+struct contention_reader_s {
+	pthread_t	thread;
+	unsigned	sweeps;
+	hrt_abstime	max_sweep;
+};
+
+static void *
+contention_reader(void *arg)
+{
+	struct contention_reader_s *r = (struct contention_reader_s *)arg;
+	const unsigned count = param_count();
+
+	while (contention.run) {
+		hrt_abstime start = hrt_absolute_time();
+
+		/* read everything, like the mavlink parameter streamer does */
+		for (unsigned i = 0; i < count; i++) {
+			param_t p = param_for_index(i);
+			int32_t val;
+
+			if (param_size(p) != sizeof(val)) {
+				continue;
+			}
+
+			if (contention.locked) {
+				pthread_mutex_lock(&contention.lock);
+				param_get(p, &val);
+				pthread_mutex_unlock(&contention.lock);
+
+			} else {
+				param_get(p, &val);
+			}
+		}
+
+		hrt_abstime elapsed = hrt_elapsed_time(&start);
+
+		if (elapsed > r->max_sweep) {
+			r->max_sweep = elapsed;
+		}
+
+		r->sweeps++;
+	}
+
+	return NULL;
+}
+
+/**
+ * One benchmark run, the test parameter is written every 100 us while the
+ * readers sweep all parameters.
+ */
+static int
+contention_run(bool locked)
+{
+	struct contention_reader_s readers[CONTENTION_READERS] = {};
+	int32_t vals[2] = { PARAM_MAGIC1, (int32_t)PARAM_MAGIC2 };
+	unsigned writes = 0;
+	int ret = 0;
+
+	contention.locked = locked;
+	contention.run = true;
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+
+	/* readers below the writer, so that it preempts them in the middle of a sweep */
+	(void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	(void)pthread_attr_setschedpolicy(&attr, SCHED_DEFAULT);
+	struct sched_param param;
+	(void)pthread_attr_getschedparam(&attr, &param);
+	param.sched_priority = SCHED_PRIORITY_DEFAULT - 10;
+	(void)pthread_attr_setschedparam(&attr, &param);
+
+	size_t stack_size = CONTENTION_STACK;
+#ifdef PTHREAD_STACK_MIN
+
+	if (stack_size < PTHREAD_STACK_MIN) {
+		stack_size = PTHREAD_STACK_MIN;
+	}
+
+#endif
+
+	if (pthread_attr_setstacksize(&attr, stack_size) != 0) {
+		warnx("failed to set reader stack size");
+		pthread_attr_destroy(&attr);
+		return 1;
+	}
+
+	unsigned started = 0;
+
+	for (; started < CONTENTION_READERS; started++) {
+		if (pthread_create(&readers[started].thread, &attr, contention_reader, &readers[started]) != 0) {
+			warnx("failed to start reader");
+			ret = 1;
+			break;
+		}
+	}
+
+	pthread_attr_destroy(&attr);
+
+	hrt_abstime start = hrt_absolute_time();
+
+	while (ret == 0 && hrt_elapsed_time(&start) < CONTENTION_DURATION) {
+		if (locked) {
+			pthread_mutex_lock(&contention.lock);
+		}
+
+		param_set_no_notification(contention.param, &vals[writes & 1]);
+
+		if (locked) {
+			pthread_mutex_unlock(&contention.lock);
+		}
+
+		writes++;
+		usleep(100);
+	}
+
+	contention.run = false;
+
+	for (unsigned i = 0; i < started; i++) {
+		pthread_join(readers[i].thread, NULL);
+	}
+
+	hrt_abstime elapsed = hrt_elapsed_time(&start);
+	unsigned sweeps = 0;
+	hrt_abstime max_sweep = 0;
+
+	for (unsigned i = 0; i < started; i++) {
+		sweeps += readers[i].sweeps;
+
+		if (readers[i].max_sweep > max_sweep) {
+			max_sweep = readers[i].max_sweep;
+		}
+	}
+
+	printf("%s: %u writes, %u read sweeps in %u ms\n", locked ? "locked   " : "lock-free",
+	       writes, sweeps, (unsigned)(elapsed / 1000));
+
+	if (sweeps > 0) {
+		printf("  avg sweep %u us, max sweep %u us\n", (unsigned)(elapsed * started / sweeps), (unsigned)max_sweep);
+	}
+
+	return ret;
+}
+
+/**
+ * Benchmark param_get() from several readers while the test parameter
+ * is written continuously, as during tuning. The locked run serializes
+ * readers and writer and shows what a reader/writer lock would cost. It is
+ * not the old behaviour: param_lock() was compiled out, so param_get() used
+ * to read without any lock and could return torn values.
+ */
+int
+test_param_contention(int argc, char *argv[])
+{
+	contention.param = param_find("test");
+
+	if (contention.param == PARAM_INVALID) {
+		warnx("test parameter not found");
+		return 1;
+	}
+
+	printf("param contention: %u readers, %u params\n", CONTENTION_READERS, param_count());
+
+	int ret = contention_run(true);
+
+	if (ret == 0) {
+		ret = contention_run(false);
+	}
+
+	param_reset(contention.param);
+
+	return ret;
+}
@@ -92,6 +92,7 @@ extern int	test_led(int argc, char *argv[]);
 extern int	test_adc(int argc, char *argv[]);
 extern int	test_int(int argc, char *argv[]);
 extern int	test_float(int argc, char *argv[]);
+extern int	test_geo(int argc, char *argv[]);
 extern int	test_ppm(int argc, char *argv[]);
 extern int	test_servo(int argc, char *argv[]);
 extern int	test_ppm_loopback(int argc, char *argv[]);
@@ -105,6 +106,7 @@ extern int	test_uart_console(int argc, char *argv[]);
 extern int	test_hott_telemetry(int argc, char *argv[]);
 extern int	test_jig_voltages(int argc, char *argv[]);
 extern int	test_param(int argc, char *argv[]);
+extern int	test_param_contention(int argc, char *argv[]);
 extern int	test_bson(int argc, char *argv[]);
 extern int	test_file(int argc, char *argv[]);
 extern int	test_file2(int argc, char *argv[]);
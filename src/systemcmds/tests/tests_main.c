@@ -81,6 +81,7 @@ const struct {
 	{"led",			test_led,	0},
 	{"int",			test_int,	0},
 	{"float",		test_float,	0},
+	{"geo",			test_geo,	OPT_NOJIGTEST},
 	{"sensors",		test_sensors,	0},
 	{"gpio",		test_gpio,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"hrt",			test_hrt,	OPT_NOJIGTEST | OPT_NOALLTEST},
@@ -103,6 +104,7 @@ const struct {
 	{"all",			test_all,	OPT_NOALLTEST | OPT_NOJIGTEST},
 	{"jig",			test_jig,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"param",		test_param,	0},
+	{"param_contention",	test_param_contention,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"bson",		test_bson,	0},
 	{"file",		test_file,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"file2",		test_file2,	OPT_NOJIGTEST},
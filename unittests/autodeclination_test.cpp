@@ -14,5 +14,20 @@
 
 TEST(AutoDeclinationTest, AutoDeclination)
 {
-	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 0.6, 0.5) << "declination differs more than 1 degree";
+	ASSERT_NEAR(get_mag_declination(47.0, 8.0), 2.2, 0.5) << "declination differs more than 0.5 degrees";
+	/* beyond the +-60 degrees latitude the old table covered */
+	ASSERT_NEAR(get_mag_declination(70.0, -150.0), 17.6, 1.0) << "declination differs more than 1 degree";
+	ASSERT_NEAR(get_mag_declination(-45.0, 170.0), 24.6, 1.0) << "declination differs more than 1 degree";
+}
+
+TEST(AutoDeclinationTest, Inclination)
+{
+	ASSERT_NEAR(get_mag_inclination(47.0, 8.0), 62.9, 0.5) << "inclination differs more than 0.5 degrees";
+	ASSERT_NEAR(get_mag_inclination(-45.0, 170.0), -70.2, 1.0) << "inclination differs more than 1 degree";
+}
+
+TEST(AutoDeclinationTest, Strength)
+{
+	ASSERT_NEAR(get_mag_strength(47.0, 8.0), 0.478, 0.005) << "field strength differs more than 5 mGauss";
+	ASSERT_NEAR(get_mag_strength(60.0, 25.0), 0.520, 0.005) << "field strength differs more than 5 mGauss";
 }
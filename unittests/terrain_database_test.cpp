@@ -0,0 +1,115 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <terrain_estimation/terrain_database.h>
+
+#include "gtest/gtest.h"
+
+#define TILE_DIR	"/tmp"
+#define TILE_SIZE	11
+
+/* tile N47E008 rising 100m per sample to the north and 10m per sample to the east */
+static void write_tile()
+{
+	struct terrain_tile_header_s header = {};
+	header.magic = TERRAIN_TILE_MAGIC;
+	header.version = TERRAIN_TILE_VERSION;
+	header.lat = 47;
+	header.lon = 8;
+	header.rows = TILE_SIZE;
+	header.cols = TILE_SIZE;
+
+	int16_t samples[TILE_SIZE][TILE_SIZE];
+
+	for (int row = 0; row < TILE_SIZE; row++) {
+		for (int col = 0; col < TILE_SIZE; col++) {
+			samples[row][col] = 400 + 100 * row + 10 * col;
+		}
+	}
+
+	samples[5][5] = TERRAIN_TILE_VOID;
+
+	FILE *f = fopen(TILE_DIR "/N47E008.ter", "wb");
+	ASSERT_TRUE(f != nullptr);
+	fwrite(&header, sizeof(header), 1, f);
+	fwrite(samples, sizeof(samples), 1, f);
+	fclose(f);
+}
+
+TEST(TerrainDatabaseTest, Elevation)
+{
+	write_tile();
+
+	TerrainDatabase database(TILE_DIR);
+	float elevation;
+
+	ASSERT_TRUE(database.elevation(47.0, 8.0, elevation));
+	ASSERT_NEAR(elevation, 400.0f, 0.01f);
+
+	/* between samples, bilinear */
+	ASSERT_TRUE(database.elevation(47.05, 8.25, elevation));
+	ASSERT_NEAR(elevation, 400.0f + 50.0f + 25.0f, 0.01f);
+
+	/* north east corner */
+	ASSERT_TRUE(database.elevation(47.99999, 8.99999, elevation));
+	ASSERT_NEAR(elevation, 400.0f + 1000.0f + 100.0f, 0.1f);
+
+	/* cells next to a void sample have no elevation */
+	ASSERT_FALSE(database.elevation(47.45, 8.45, elevation));
+
+	/* no tile */
+	ASSERT_FALSE(database.elevation(46.5, 8.5, elevation));
+	ASSERT_FALSE(database.elevation(91.0, 8.5, elevation));
+
+	unlink(TILE_DIR "/N47E008.ter");
+}
+
+TEST(TerrainDatabaseTest, Clearance)
+{
+	write_tile();
+
+	TerrainDatabase database(TILE_DIR);
+	float clearance;
+
+	/* climbing north along the west edge, the terrain rises faster */
+	ASSERT_TRUE(database.min_clearance(47.0, 8.0, 500.0f, 47.3, 8.0, 600.0f, clearance));
+	ASSERT_NEAR(clearance, 600.0f - 700.0f, 0.1f);
+
+	/* crosses the void */
+	ASSERT_FALSE(database.min_clearance(47.5, 8.0, 2000.0f, 47.5, 8.9, 2000.0f, clearance));
+
+	/* leaves the tile */
+	ASSERT_FALSE(database.min_clearance(47.1, 8.1, 2000.0f, 46.9, 8.1, 2000.0f, clearance));
+
+	unlink(TILE_DIR "/N47E008.ter");
+}
+
+TEST(TerrainDatabaseTest, Block)
+{
+	write_tile();
+
+	TerrainDatabase database(TILE_DIR);
+	int16_t samples[4 * 4];
+	struct terrain_block_s block;
+
+	/* at the north west corner the block is moved inside the tile */
+	ASSERT_TRUE(database.read_block(47.95, 8.05, 4, samples, block));
+	ASSERT_EQ(block.lat, 47);
+	ASSERT_EQ(block.lon, 8);
+	ASSERT_EQ(block.row, TILE_SIZE - 4);
+	ASSERT_EQ(block.col, 0);
+	ASSERT_EQ(samples[0], 400 + 100 * (TILE_SIZE - 4));
+	ASSERT_EQ(samples[4 * 4 - 1], 400 + 100 * (TILE_SIZE - 1) + 10 * 3);
+
+	/* larger than the tile */
+	int16_t large[(TILE_SIZE + 1) * (TILE_SIZE + 1)];
+	ASSERT_FALSE(database.read_block(47.5, 8.5, TILE_SIZE + 1, large, block));
+
+	/* no tile */
+	ASSERT_FALSE(database.read_block(46.5, 8.5, 4, samples, block));
+
+	unlink(TILE_DIR "/N47E008.ter");
+}